@@ -0,0 +1,91 @@
+#include "bench.h"
+
+// Values parsed per mode (spread over as many command lines as it takes)
+const long values = 20000000;
+
+typedef struct Filters
+{
+    long count;
+    int64_t sum;
+} Filters;
+
+static void PushFilter(ArgHandle handle, ArgItem value, void *data)
+{
+    Filters *filters = (Filters *) data;
+    (void) handle;
+    filters->count++;
+    filters->sum += value.i;
+}
+
+static void SetMode(ArgHandle handle, ArgItem value, void *data)
+{
+    (void) handle;
+    *(int64_t *) data += value.i;
+}
+
+int main(int argc, const char *argv[])
+{
+    // actions.exe [filters]: -vvv -m, then that many -f <number>, read back after parsing vs handled by actions while parsing
+    int count = (argc > 1) ? atoi(argv[1]) : 1000;
+    if (count < 1 || count > 100000) return 1;
+    int parses = (int) (values / count);
+
+    static char numbers[100000][16];
+    const char **line = (const char **) malloc((3 + 2 * count) * sizeof(char *));
+    int lineCount = 0;
+    line[lineCount++] = "actions";
+    line[lineCount++] = "-vvv";
+    line[lineCount++] = "-m";
+    for (int i = 0; i < count; i++)
+    {
+        sprintf(numbers[i], "%i", i);
+        line[lineCount++] = "-f";
+        line[lineCount++] = numbers[i];
+    }
+
+    // Stored: values kept in a list, then read back with the getters
+    SAH_Parser stored = { 0 };
+    ArgHandle verbose = SAH_AddOptionalArg(&stored, "v", "verbose", "Verbosity", ARG_COUNT);
+    ArgHandle mode = SAH_AddOptionalArg(&stored, "m", "mode", "Toggle mode", ARG_BOOL);
+    ArgHandle filter = SAH_AddOptionalArg(&stored, "f", "filter", "Filter", ARG_INT64 | ARG_LIST);
+    SAH_InitArgs(&stored, lineCount, line, "Actions benchmark");
+
+    int64_t storedSum = 0;
+    double start = Now();
+    for (int p = 0; p < parses; p++)
+    {
+        SAH_ParseArgs(&stored, lineCount, line);
+        storedSum += SAH_GetIntArgH(&stored, verbose) + SAH_GetBoolArgH(&stored, mode);
+        for (int i = 0, n = SAH_GetArgCountH(&stored, filter); i < n; i++)
+            storedSum += SAH_GetInt64ArgAtH(&stored, filter, i);
+    }
+    double storedElapsed = Now() - start;
+
+    // Actions: each value handled as it's parsed, nothing stored or looked up afterwards
+    SAH_Parser inline_ = { 0 };
+    Filters filters = { 0, 0 };
+    int64_t modes = 0;
+    SAH_AddOptionalArg(&inline_, "v", "verbose", "Verbosity", ARG_COUNT);
+    SAH_SetArgAction(&inline_, SAH_AddOptionalArg(&inline_, "m", "mode", "Toggle mode", ARG_BOOL), SetMode, &modes);
+    SAH_SetArgAction(&inline_, SAH_AddOptionalArg(&inline_, "f", "filter", "Filter", ARG_INT64 | ARG_LIST), PushFilter, &filters);
+    SAH_InitArgs(&inline_, lineCount, line, "Actions benchmark");
+
+    int64_t inlineSum = 0;
+    start = Now();
+    for (int p = 0; p < parses; p++)
+    {
+        filters.sum = 0;
+        SAH_ParseArgs(&inline_, lineCount, line);
+        inlineSum += SAH_GetIntArg(&inline_, "verbose") + filters.sum;
+    }
+    double inlineElapsed = Now() - start;
+
+    printf("filters=%i ns_per_parse_stored=%.0f ns_per_parse_actions=%.0f ns_per_value_stored=%.2f ns_per_value_actions=%.2f checksum=%lld/%lld\n",
+           count, storedElapsed / parses, inlineElapsed / parses, storedElapsed / parses / count, inlineElapsed / parses / count,
+           (long long) storedSum, (long long) (inlineSum + modes - 1));
+
+    SAH_FreeArgs(&stored);
+    SAH_FreeArgs(&inline_);
+    free(line);
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include "bench.h"
+
+int main(int argc, const char *argv[])
+{
+    // alloc.exe [buffer] [count]: register count options and parse a value for each
+    bool useBuffer = argc > 1 && !strcmp(argv[1], "buffer");
+    int count = (argc > 2) ? atoi(argv[2]) : 100;
+    const char *digits = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+    static unsigned char buffer[1 << 22];
+    if (useBuffer) SetArgBuffer(buffer, sizeof(buffer));
+
+    // Short names are stored with a leading hyphen so they can be passed as argv too
+    static char flags[5000][SAH_SHORT_NAME_MAX + 2], longNames[5000][SAH_LONG_NAME_MAX + 1];
+    static const char *fakeArgv[5000 * 2 + 1];
+    fakeArgv[0] = "alloc";
+    int fakeArgc = 1;
+
+    double start = Now();
+    for (int i = 0; i < count; i++)
+    {
+        sprintf(flags[i], "-%c%c%c", digits[(i / 1296) % 36], digits[(i / 36) % 36], digits[i % 36]);
+        sprintf(longNames[i], "option-%i", i);
+        AddOptionalArg(&flags[i][1], longNames[i], "Synthetic option", (i & 1) ? ARG_STRING : ARG_BOOL);
+
+        // Every option is used, strings get a value
+        fakeArgv[fakeArgc++] = flags[i];
+        if (i & 1) fakeArgv[fakeArgc++] = "value";
+    }
+
+    InitArgs(fakeArgc, fakeArgv, "Allocation benchmark");
+    FreeArgs();
+    double elapsed = Now() - start;
+
+    printf("mode=%s options=%i malloc_calls=%ld us_total=%.1f\n", useBuffer ? "buffer" : "heap", count, heapCalls, elapsed / 1000);
+    return 0;
+}
@@ -0,0 +1,44 @@
+#ifndef BENCH_H
+    #define BENCH_H
+
+    // Shared by the benchmarks: the clock, and heap call counters for the ones linked with -Wl,--wrap=malloc
+    // (BENCH_WRAP_MALLOC) and -Wl,--wrap=realloc (BENCH_WRAP_REALLOC), see WRAP_MALLOC and WRAP_HEAP in the Makefile
+    #include <time.h>
+    #include "../simplearghandler.h"
+
+    // Nanoseconds on clock (CLOCK_THREAD_CPUTIME_ID for one thread's CPU time)
+    static double NowOn(clockid_t clock)
+    {
+        struct timespec ts;
+        clock_gettime(clock, &ts);
+        return ts.tv_sec * 1e9 + ts.tv_nsec;
+    }
+
+    static double Now(void)
+    {
+        return NowOn(CLOCK_MONOTONIC);
+    }
+
+    #if defined(BENCH_WRAP_MALLOC) || defined(BENCH_WRAP_REALLOC)
+        // Heap calls made so far (by the library and the benchmark)
+        static long heapCalls = 0;
+    #endif
+
+    #ifdef BENCH_WRAP_MALLOC
+        void *__real_malloc(size_t size);
+        void *__wrap_malloc(size_t size)
+        {
+            heapCalls++;
+            return __real_malloc(size);
+        }
+    #endif
+
+    #ifdef BENCH_WRAP_REALLOC
+        void *__real_realloc(void *pointer, size_t size);
+        void *__wrap_realloc(void *pointer, size_t size)
+        {
+            heapCalls++;
+            return __real_realloc(pointer, size);
+        }
+    #endif
+#endif
@@ -0,0 +1,74 @@
+#include "bench.h"
+
+// Values parsed and dispatched per mode (spread over as many command lines as it takes)
+const long values = 20000000;
+// Values on one command line
+#define LINE_VALUES 1000
+
+int main(int argc, const char *argv[])
+{
+    // choices.exe [choices]: LINE_VALUES -f <choice> values, as strings matched with a strcmp() chain vs as ARG_CHOICE indexes
+    int count = (argc > 1) ? atoi(argv[1]) : 8;
+    if (count < 1 || count > 256) return 1;
+    int parses = (int) (values / LINE_VALUES);
+
+    static char names[256][16];
+    const char *choices[256];
+    for (int i = 0; i < count; i++)
+    {
+        sprintf(names[i], "format%i", i);
+        choices[i] = names[i];
+    }
+
+    const char *line[1 + 2 * LINE_VALUES];
+    int lineCount = 0;
+    line[lineCount++] = "choices";
+    for (int i = 0; i < LINE_VALUES; i++)
+    {
+        line[lineCount++] = "-f";
+        line[lineCount++] = choices[(i * 7) % count];
+    }
+
+    // Strings: every value kept as text, the caller finds which one it is
+    SAH_Parser strings = { 0 };
+    ArgHandle text = SAH_AddOptionalArg(&strings, "f", "format", "Format", ARG_STRING | ARG_LIST);
+    SAH_InitArgs(&strings, lineCount, line, "Choices benchmark");
+
+    long stringSum = 0;
+    double start = Now();
+    for (int p = 0; p < parses; p++)
+    {
+        SAH_ParseArgs(&strings, lineCount, line);
+        for (int i = 0, n = SAH_GetArgCountH(&strings, text); i < n; i++)
+        {
+            const char *value = SAH_GetArgAtH(&strings, text, i);
+            int choice = 0;
+            for (; choice < count && strcmp(value, choices[choice]); choice++);
+            stringSum += choice;
+        }
+    }
+    double stringElapsed = Now() - start;
+
+    // Choices: matched while parsing, the caller gets the index
+    SAH_Parser indexes = { 0 };
+    ArgHandle choice = SAH_AddOptionalArg(&indexes, "f", "format", "Format", ARG_CHOICE | ARG_LIST);
+    SAH_SetArgChoices(&indexes, choice, choices, count);
+    SAH_InitArgs(&indexes, lineCount, line, "Choices benchmark");
+
+    long choiceSum = 0;
+    start = Now();
+    for (int p = 0; p < parses; p++)
+    {
+        SAH_ParseArgs(&indexes, lineCount, line);
+        for (int i = 0, n = SAH_GetArgCountH(&indexes, choice); i < n; i++)
+            choiceSum += SAH_GetChoiceArgAtH(&indexes, choice, i);
+    }
+    double choiceElapsed = Now() - start;
+
+    printf("choices=%i ns_per_value_strings=%.2f ns_per_value_choices=%.2f checksum=%ld/%ld\n",
+           count, stringElapsed / values, choiceElapsed / values, stringSum, choiceSum);
+
+    SAH_FreeArgs(&strings);
+    SAH_FreeArgs(&indexes);
+    return 0;
+}
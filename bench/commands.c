@@ -0,0 +1,72 @@
+#include "bench.h"
+
+// Launches timed per run
+const int launches = 2000;
+
+static const char *digits = "0123456789abcdefghijklmnopqrstuvwxyz";
+static char shortNames[50000][SAH_SHORT_NAME_MAX + 1], longNames[50000][SAH_LONG_NAME_MAX + 1];
+static int commandCount = 40, optionCount = 50;
+
+// Every command has the same number of options (names are only unique within a command)
+static void SetupCommand(SAH_Parser *parser)
+{
+    for (int i = 0; i < optionCount; i++)
+        SAH_AddOptionalArg(parser, shortNames[i], longNames[i], "Synthetic option", ARG_INT);
+}
+
+int main(int argc, const char *argv[])
+{
+    // commands.exe [commands] [options per command]: a multi-tool launched with one command,
+    // with every command's options registered up front (flat) vs only the selected command's (lazy)
+    if (argc > 1) commandCount = atoi(argv[1]);
+    if (argc > 2) optionCount = atoi(argv[2]);
+    if (commandCount < 1 || optionCount < 1 || commandCount * optionCount > 40000) return 1;
+
+    static char commandNames[1000][SAH_LONG_NAME_MAX + 1];
+    for (int i = 0; i < commandCount * optionCount; i++)
+    {
+        sprintf(shortNames[i], "%c%c%c", digits[(i / 1296) % 36], digits[(i / 36) % 36], digits[i % 36]);
+        sprintf(longNames[i], "option-%i", i);
+    }
+    for (int i = 0; i < commandCount && i < 1000; i++)
+        sprintf(commandNames[i], "command%i", i);
+
+    // Flat: the last command's options are the last ones registered
+    const char *flatLine[] = { "tool", "--option-0", "5", "-001", "7" };
+    char lastLong[SAH_LONG_NAME_MAX + 3], lastShort[SAH_SHORT_NAME_MAX + 2];
+    sprintf(lastLong, "--%s", longNames[(commandCount - 1) * optionCount]);
+    sprintf(lastShort, "-%s", shortNames[(commandCount - 1) * optionCount + 1]);
+    flatLine[1] = lastLong;
+    flatLine[3] = lastShort;
+
+    long checksum = 0;
+    double start = Now();
+    for (int launch = 0; launch < launches; launch++)
+    {
+        SAH_Parser parser = { 0 };
+        for (int i = 0; i < commandCount * optionCount; i++)
+            SAH_AddOptionalArg(&parser, shortNames[i], longNames[i], "Synthetic option", ARG_INT);
+        SAH_InitArgs(&parser, 5, flatLine, "Multi-tool benchmark");
+        checksum += SAH_GetIntArg(&parser, &lastLong[2]);
+        SAH_FreeArgs(&parser);
+    }
+    double flatElapsed = Now() - start;
+
+    // Lazy: the last command is selected
+    const char *commandLine[] = { "tool", commandNames[commandCount - 1], "--option-0", "5", "-001", "7" };
+    start = Now();
+    for (int launch = 0; launch < launches; launch++)
+    {
+        SAH_Parser parser = { 0 };
+        for (int i = 0; i < commandCount; i++)
+            SAH_AddCommand(&parser, commandNames[i], "Synthetic command", SetupCommand);
+        SAH_InitArgs(&parser, 6, commandLine, "Multi-tool benchmark");
+        checksum += SAH_GetIntArg(&parser, "option-0");
+        SAH_FreeArgs(&parser);
+    }
+    double commandElapsed = Now() - start;
+
+    printf("commands=%i options_per_command=%i ns_per_launch_flat=%.0f ns_per_launch_commands=%.0f checksum=%ld\n",
+           commandCount, optionCount, flatElapsed / launches, commandElapsed / launches, checksum);
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "bench.h"
+
+// Number of prefixes looked up per run
+const int queries = 100000;
+
+int main(int argc, const char *argv[])
+{
+    // complete.exe [options]: that many long names like --cache-size-00042, completed and abbreviated
+    int count = (argc > 1) ? atoi(argv[1]) : 1000;
+    const char *words[] = { "cache", "color", "disable", "enable", "log", "max", "min", "no", "output", "verbose" };
+    int wordCount = (int) (sizeof(words) / sizeof(words[0]));
+    const char *ends[] = { "size", "level", "path", "count", "mode" };
+    const char *letters = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+    if (count < 1 || count > 30000) return 1;
+
+    static char shortNames[30000][SAH_SHORT_NAME_MAX + 1], longNames[30000][SAH_LONG_NAME_MAX + 1];
+    SAH_Parser parser = { 0 };
+    double start = Now();
+    for (int i = 0; i < count; i++)
+    {
+        sprintf(shortNames[i], "%c%c%c", letters[10 + i % 26], letters[(i / 26) % 36], letters[(i / 936) % 36]);
+        sprintf(longNames[i], "%s-%s-%05i", words[i % wordCount], ends[(i / wordCount) % 5], i);
+        SAH_AddOptionalArg(&parser, shortNames[i], longNames[i], "Synthetic option", ARG_BOOL);
+    }
+    const char *line[] = { "complete" };
+    SAH_InitArgs(&parser, 1, line, "Completion benchmark");
+    double registerElapsed = Now() - start;
+
+    // What a --complete run does after registering: build the trie, then one lookup
+    start = Now();
+    BuildTrie(&parser);
+    double buildElapsed = Now() - start;
+
+    // Prefixes of every length, from "" (every name) to whole names
+    static char prefixes[1000][SAH_LONG_NAME_MAX + 1];
+    for (int i = 0; i < 1000; i++)
+    {
+        const char *name = longNames[(i * 2654435761u) % (unsigned int) count];
+        size_t length = strlen(name) * (i % 8) / 7;
+        snprintf(prefixes[i], sizeof(prefixes[i]), "%.*s", (int) length, name);
+    }
+
+    long candidates = 0;
+    start = Now();
+    for (int i = 0; i < queries; i++)
+    {
+        const char *prefix = prefixes[i % 1000];
+        ArgTrieNode *node = SearchTrie(&parser, prefix, strlen(prefix));
+        // Walk the candidates the way CompleteArgs() prints them
+        for (int j = (node != NULL) ? node->start : 0; node != NULL && j < node->end; j++)
+            candidates += parser.trieArgs[j]->longName[0] != '\0';
+    }
+    double queryElapsed = Now() - start;
+
+    // Abbreviated lookups: names without their last digit are still unique, since the ten names sharing the rest have different words
+    int found = 0;
+    start = Now();
+    for (int i = 0; i < queries; i++)
+    {
+        const char *name = longNames[(i * 2654435761u) % (unsigned int) count];
+        found += SearchPrefix(&parser, name, strlen(name) - 1) != NULL;
+    }
+    double prefixElapsed = Now() - start;
+
+    printf("options=%i us_register=%.1f us_build_trie=%.1f ns_per_completion=%.1f candidates_per_completion=%.1f ns_per_abbreviation=%.1f us_complete_total=%.1f found=%i\n",
+           count, registerElapsed / 1e3, buildElapsed / 1e3, queryElapsed / queries, (double) candidates / queries, prefixElapsed / queries,
+           (buildElapsed + queryElapsed / queries) / 1e3, found);
+
+    SAH_FreeArgs(&parser);
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include "bench.h"
+
+int main(int argc, const char *argv[])
+{
+    // errors.exe [command lines]: parse untrusted command lines in process with TryParseArgs(), half of them wrong
+    int count = (argc > 1) ? atoi(argv[1]) : 1000000;
+
+    char message[256];
+    SAH_Parser parser = { 0 };
+    SAH_SetErrorBuffer(&parser, message, sizeof(message));
+    SAH_AddPositionalArg(&parser, "File path", "Path to file", ARG_STRING);
+    SAH_AddOptionalArg(&parser, "n", "number", "Show line number", ARG_BOOL);
+    SAH_AddOptionalArg(&parser, "l", "max-lines", "Show a specified number of lines", ARG_INT);
+
+    const char *good[] = { "cmd", "-n", "--max-lines", "25", "input.txt" };
+    const char *unknown[] = { "cmd", "--bogus", "input.txt" };
+    const char *invalid[] = { "cmd", "-l", "x25", "input.txt" };
+    const char *missing[] = { "cmd", "-n" };
+    const char **lines[] = { good, unknown, good, invalid, good, missing };
+    int lineCounts[] = { 5, 3, 5, 4, 5, 2 };
+
+    SAH_TryInitArgs(&parser, 5, good, "Error benchmark");
+
+    long errors = 0, checksum = 0;
+    double start = Now();
+    for (int i = 0; i < count; i++)
+    {
+        if (SAH_TryParseArgs(&parser, lineCounts[i % 6], lines[i % 6]) != SAH_OK)
+            checksum += (long) strlen(message), errors++;
+        else
+            checksum += SAH_GetIntArg(&parser, "l");
+    }
+    double elapsed = Now() - start;
+
+    printf("command_lines=%i errors=%ld checksum=%ld ns_per_parse=%.1f\n", count, errors, checksum, elapsed / count);
+
+    SAH_FreeArgs(&parser);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "bench.h"
+
+// Number of lookups timed per run
+const int lookups = 1000000;
+
+int main(int argc, const char *argv[])
+{
+    // flags.exe [flags] [parses]: that many ARG_BOOL flags, every one given (one character ones bundled 8 to a token)
+    int count = (argc > 1) ? atoi(argv[1]) : 200;
+    int parses = (argc > 2) ? atoi(argv[2]) : 100000;
+    const char *letters = "0123456789abcdefgijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    int letterCount = (int) strlen(letters);
+
+    if (count < 1 || count > 1000) return 1;
+
+    static char shortNames[1000][SAH_SHORT_NAME_MAX + 1], longNames[1000][SAH_LONG_NAME_MAX + 1];
+    static ArgHandle handles[1000];
+    for (int i = 0; i < count; i++)
+    {
+        if (i < letterCount) sprintf(shortNames[i], "%c", letters[i]);
+        else sprintf(shortNames[i], "f%c%c", letters[(i - letterCount) / 36], letters[(i - letterCount) % 36]);
+        sprintf(longNames[i], "flag-%i", i);
+        handles[i] = AddOptionalArg(shortNames[i], longNames[i], "Synthetic flag", ARG_BOOL);
+    }
+
+    // -0123456 -789abcde ... -f00 -f01 ...
+    static char text[1000][SAH_SHORT_NAME_MAX + 10];
+    static const char *line[1000];
+    int lineCount = 0;
+    line[lineCount++] = "flags";
+    for (int i = 0; i < count; )
+    {
+        char *token = text[lineCount];
+        int length = 0;
+        token[length++] = '-';
+        if (i < letterCount)
+            for (int bundled = 0; bundled < 8 && i < count && i < letterCount; bundled++)
+                token[length++] = shortNames[i++][0];
+        else
+            length += sprintf(&token[length], "%s", shortNames[i++]);
+        token[length] = '\0';
+        line[lineCount++] = token;
+    }
+
+    InitArgs(lineCount, line, "Flag benchmark");
+    long setupCalls = heapCalls;
+
+    double start = Now();
+    for (int i = 0; i < parses; i++)
+        ParseArgs(lineCount, line);
+    double parseElapsed = Now() - start;
+    long parseCalls = heapCalls - setupCalls;
+
+    int set = 0;
+    for (int i = 0; i < count; i++) set += GetBoolArgH(handles[i]);
+
+    start = Now();
+    for (int i = 0; i < lookups; i++)
+        set += GetBoolArgH(handles[(i * 2654435761u) % (unsigned int) count]);
+    double handleElapsed = Now() - start;
+
+    start = Now();
+    for (int i = 0; i < lookups; i++)
+        set += GetBoolArg(longNames[(i * 2654435761u) % (unsigned int) count]);
+    double nameElapsed = Now() - start;
+
+    printf("flags=%i tokens=%i ns_per_parse=%.1f ns_per_flag=%.2f heap_calls_per_parse=%.2f ns_per_get_handle=%.2f ns_per_get_name=%.2f set=%i\n",
+           count, lineCount - 1, parseElapsed / parses, parseElapsed / ((double) parses * count), (double) parseCalls / parses,
+           handleElapsed / lookups, nameElapsed / lookups, set);
+
+    FreeArgs();
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <pthread.h>
+#include "bench.h"
+
+// Reads per thread, args read in turn
+static long readsPerThread = 20000000;
+#define ARGS 16
+
+static SAH_Parser parser;
+static const SAH_FrozenArgs *frozen;
+static ArgHandle handles[ARGS];
+static char names[ARGS][16];
+
+typedef struct Job
+{
+    // 0: Get*Arg() by name, 1: by handle, 2: frozen
+    int mode;
+    long checksum;
+    double cpu;
+} Job;
+
+static void* Reader(void *data)
+{
+    Job *job = (Job *) data;
+    long checksum = 0;
+    double start = NowOn(CLOCK_THREAD_CPUTIME_ID);
+
+    if (job->mode == 0)
+        for (long i = 0; i < readsPerThread; i++) checksum += SAH_GetIntArg(&parser, names[i % ARGS]);
+    else if (job->mode == 1)
+        for (long i = 0; i < readsPerThread; i++) checksum += SAH_GetIntArgH(&parser, handles[i % ARGS]);
+    else
+        for (long i = 0; i < readsPerThread; i++) checksum += SAH_FrozenInt(frozen, handles[i % ARGS]);
+
+    job->cpu = NowOn(CLOCK_THREAD_CPUTIME_ID) - start;
+    job->checksum = checksum;
+    return NULL;
+}
+
+int main(int argc, const char *argv[])
+{
+    // frozen.exe [max threads] [reads per thread]: 1, 2, 4... threads reading the same parsed values
+    int maxThreads = (argc > 1) ? atoi(argv[1]) : 64;
+    if (argc > 2) readsPerThread = atol(argv[2]);
+
+    // --option0 0 --option1 3 ...
+    const char *line[1 + 2 * ARGS];
+    static char options[ARGS][20], values[ARGS][16];
+    line[0] = "frozen";
+    for (int i = 0; i < ARGS; i++)
+    {
+        char shortName[4];
+        sprintf(shortName, "o%i", i);
+        sprintf(names[i], "option%i", i);
+        handles[i] = SAH_AddOptionalArg(&parser, shortName, names[i], "Option", ARG_INT);
+
+        sprintf(options[i], "--%s", names[i]);
+        sprintf(values[i], "%i", i * 3);
+        line[1 + 2 * i] = options[i];
+        line[2 + 2 * i] = values[i];
+    }
+    SAH_InitArgs(&parser, 1 + 2 * ARGS, line, "Frozen benchmark");
+    frozen = SAH_FreezeArgs(&parser);
+
+    const char *modeNames[] = { "name", "handle", "frozen" };
+    pthread_t threads[256];
+    Job jobs[256];
+    for (int mode = 0; mode < 3; mode++)
+    {
+        for (int count = 1; count <= maxThreads && count <= 256; count *= 2)
+        {
+            double start = Now();
+            for (int i = 0; i < count; i++)
+            {
+                jobs[i].mode = mode;
+                pthread_create(&threads[i], NULL, Reader, &jobs[i]);
+            }
+            double cpu = 0;
+            long checksum = 0;
+            for (int i = 0; i < count; i++)
+            {
+                pthread_join(threads[i], NULL);
+                cpu += jobs[i].cpu;
+                checksum += jobs[i].checksum;
+            }
+            double elapsed = Now() - start;
+
+            // ns_per_read is CPU time, so it stays comparable with more threads than cores
+            printf("mode=%s threads=%i ns_per_read=%.2f reads_per_sec=%.0f checksum=%ld\n", modeNames[mode], count,
+                   cpu / ((double) count * readsPerThread), count * readsPerThread / (elapsed / 1e9), checksum);
+        }
+    }
+
+    SAH_FreeFrozenArgs(frozen);
+    SAH_FreeArgs(&parser);
+    return 0;
+}
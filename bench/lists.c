@@ -0,0 +1,38 @@
+#include "bench.h"
+
+int main(int argc, const char *argv[])
+{
+    // lists.exe [values]: parse that many positional paths plus that many "-I dir" pairs
+    int count = (argc > 1) ? atoi(argv[1]) : 1000000;
+
+    const char **fakeArgv = (const char **) malloc((count * 3 + 1) * sizeof(const char *));
+    int fakeArgc = 0;
+    fakeArgv[fakeArgc++] = "lists";
+    for (int i = 0; i < count; i++)
+    {
+        fakeArgv[fakeArgc++] = "-I";
+        fakeArgv[fakeArgc++] = "/usr/include";
+        fakeArgv[fakeArgc++] = "input.txt";
+    }
+
+    ArgHandle files = AddPositionalArg("files", "Input files", ARG_STRING | ARG_LIST);
+    ArgHandle includes = AddOptionalArg("I", "include", "Include directory", ARG_STRING | ARG_LIST);
+
+    double start = Now();
+    InitArgs(fakeArgc, fakeArgv, "List benchmark");
+    double elapsed = Now() - start;
+
+    // Read every value back
+    size_t total = 0;
+    start = Now();
+    for (int i = 0; i < GetArgCountH(files); i++) total += GetArgAtH(files, i)[0];
+    for (int i = 0; i < GetArgCountH(includes); i++) total += GetArgAtH(includes, i)[0];
+    double readElapsed = Now() - start;
+
+    printf("values=%i checksum=%zu ns_per_value=%.2f ns_per_read=%.2f\n", GetArgCountH(files) + GetArgCountH(includes),
+           total, elapsed / (count * 2), readElapsed / (count * 2));
+
+    FreeArgs();
+    free(fakeArgv);
+    return 0;
+}
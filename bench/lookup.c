@@ -0,0 +1,48 @@
+#include "bench.h"
+
+// Number of lookups timed per run
+const int lookups = 1000000;
+
+int main(int argc, const char *argv[])
+{
+    // Number of options to register (e.g. 5, 50, 500, 5000)
+    int count = (argc > 1) ? atoi(argv[1]) : 5;
+    const char *digits = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+    // Long names share the same prefix so the old first-letter buckets collide
+    static char shortNames[50000][SAH_SHORT_NAME_MAX + 1], longNames[50000][SAH_LONG_NAME_MAX + 1];
+    static ArgHandle handles[50000];
+    for (int i = 0; i < count; i++)
+    {
+        sprintf(shortNames[i], "%c%c%c", digits[(i / 1296) % 36], digits[(i / 36) % 36], digits[i % 36]);
+        sprintf(longNames[i], "stats-dir-%i", i);
+        handles[i] = AddOptionalArg(shortNames[i], longNames[i], "Synthetic option", ARG_BOOL);
+    }
+
+    const char *fakeArgv[] = { "lookup" };
+    InitArgs(1, fakeArgv, "Lookup benchmark");
+
+    // Alternate between short and long names, spread over all options
+    int found = 0;
+    double start = Now();
+    for (int i = 0; i < lookups; i++)
+    {
+        int n = (int) ((i * 2654435761u) % (unsigned int) count);
+        found += GetBoolArg((i & 1) ? longNames[n] : shortNames[n]) ? 0 : 1;
+    }
+    double elapsed = Now() - start;
+
+    // Same accesses through handles
+    start = Now();
+    for (int i = 0; i < lookups; i++)
+    {
+        int n = (int) ((i * 2654435761u) % (unsigned int) count);
+        found += GetBoolArgH(handles[n]) ? 0 : 1;
+    }
+    double handleElapsed = Now() - start;
+
+    printf("options=%i found=%i ns_per_lookup=%.2f ns_per_handle=%.2f\n", count, found, elapsed / lookups, handleElapsed / lookups);
+
+    FreeArgs();
+    return 0;
+}
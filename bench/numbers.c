@@ -0,0 +1,48 @@
+#include "bench.h"
+
+int main(int argc, const char *argv[])
+{
+    // numbers.exe [millions]: parse that many integer and decimal strings with atof and with the library's parsers
+    int count = ((argc > 1) ? atoi(argv[1]) : 4) * 1000000;
+
+    // Pool of values to cycle through
+    enum { POOL = 4096 };
+    static char integers[POOL][24], decimals[POOL][32];
+    srand(1);
+    for (int i = 0; i < POOL; i++)
+    {
+        sprintf(integers[i], "%lld", (long long) rand() * rand() - RAND_MAX);
+        sprintf(decimals[i], "%d.%04de%d", rand() % 100000, rand() % 10000, rand() % 20 - 10);
+    }
+
+    double sum = 0, start = Now();
+    for (int i = 0; i < count; i++) sum += atof(integers[i % POOL]);
+    double atofInt = Now() - start;
+
+    start = Now();
+    for (int i = 0; i < count; i++)
+    {
+        int64_t value;
+        ParseSigned(integers[i % POOL], &value);
+        sum -= (double) value;
+    }
+    double parseInt = Now() - start;
+
+    start = Now();
+    for (int i = 0; i < count; i++) sum += atof(decimals[i % POOL]);
+    double atofDecimal = Now() - start;
+
+    start = Now();
+    for (int i = 0; i < count; i++)
+    {
+        double value;
+        ParseDouble(decimals[i % POOL], &value);
+        sum -= value;
+    }
+    double parseDecimal = Now() - start;
+
+    printf("values=%i check=%g\n", count, sum);
+    printf("integer atof_ns=%.2f ParseSigned_ns=%.2f\n", atofInt / count, parseInt / count);
+    printf("decimal atof_ns=%.2f ParseDouble_ns=%.2f\n", atofDecimal / count, parseDecimal / count);
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <sys/resource.h>
+#include "bench.h"
+
+// Number of lookups timed per run
+const int lookups = 1000000;
+// About this many tokens are parsed per run, split over repeated parses
+const long totalTokens = 2000000;
+// Most tokens on one command line (each has its own text)
+#define MAX_TOKENS 100000
+
+int main(int argc, const char *argv[])
+{
+    // parse.exe [options] [collide|spread] [short|long|bundled|positional] [tokens per command line] [lazy]
+    int count = (argc > 1) ? atoi(argv[1]) : 5;
+    bool collide = (argc > 2) && !strcmp(argv[2], "collide");
+    const char *shape = (argc > 3) ? argv[3] : "short";
+    int tokens = (argc > 4) ? atoi(argv[4]) : 1000;
+    bool lazy = (argc > 5) && !strcmp(argv[5], "lazy");
+    const char *digits = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+    if (count < 1 || count > 10000 || tokens < 1 || tokens > MAX_TOKENS) return 1;
+
+    // Schema: even options take an int, odd ones are flags.
+    // Colliding names pack into as few first letters as possible, spread names cycle through all 36
+    static char shortNames[10000][SAH_SHORT_NAME_MAX + 1], longNames[10000][SAH_LONG_NAME_MAX + 1];
+    for (int i = 0; i < count; i++)
+    {
+        if (collide)
+            sprintf(shortNames[i], "%c%c%c", digits[10 + i / 1296], digits[(i / 36) % 36], digits[i % 36]);
+        else
+            sprintf(shortNames[i], "%c%c%c", digits[i % 36], digits[(i / 36) % 36], digits[(i / 1296) % 36]);
+        sprintf(longNames[i], "%s-option-%i", collide ? "same" : shortNames[i], i);
+    }
+
+    SAH_Parser parser = { 0 };
+    SAH_SetLazyArgs(&parser, lazy);
+    double start = Now();
+    SAH_AddPositionalArg(&parser, "files", "Input files", ARG_STRING | ARG_LIST);
+    for (int i = 0; i < count; i++)
+        SAH_AddOptionalArg(&parser, shortNames[i], longNames[i], "Synthetic option", (i & 1) ? ARG_BOOL : ARG_INT);
+    // Bundles: one character flags A-H and an int V (other names are three characters, so they don't clash)
+    static char bundleShort[9][2], bundleLong[9][16];
+    bool bundled = !strcmp(shape, "bundled");
+    for (int i = 0; bundled && i < 9; i++)
+    {
+        sprintf(bundleShort[i], "%c", (i < 8) ? 'A' + i : 'V');
+        sprintf(bundleLong[i], "bundle-%c", bundleShort[i][0]);
+        SAH_AddOptionalArg(&parser, bundleShort[i], bundleLong[i], "Synthetic option", (i < 8) ? ARG_BOOL : ARG_INT);
+    }
+    double registerElapsed = Now() - start;
+
+    // Command line of about 'tokens' tokens in the given shape
+    static char text[MAX_TOKENS][SAH_LONG_NAME_MAX + 8];
+    const char **line = (const char **) malloc((tokens + 3) * sizeof(char *));
+    int lineCount = 0;
+    line[lineCount++] = "parse";
+    for (int t = 0; lineCount <= tokens; t++)
+    {
+        int n = (int) ((t * 2654435761u) % (unsigned int) count);
+        char *token = text[t];
+
+        // Positional heavy: 9 files for each option
+        if (!strcmp(shape, "positional") && t % 10 != 0)
+            sprintf(token, "file-%i.txt", t);
+        else if (!strcmp(shape, "long"))
+            sprintf(token, (n & 1) ? "--%s" : "--%s=42", longNames[n]);
+        // Every other bundle ends with V, which takes the next token (-ABCDEFGH, -DEFV 42)
+        else if (bundled)
+        {
+            int flags = (t & 1) ? 3 : 8;
+            token[0] = '-';
+            for (int c = 0; c < flags; c++) token[c + 1] = 'A' + (t + c) % 8;
+            token[flags + 1] = (t & 1) ? 'V' : '\0';
+            token[flags + 2] = '\0';
+            n = (t & 1) ? 0 : 1;
+        }
+        else
+            sprintf(token, "-%s", shortNames[n]);
+        line[lineCount++] = token;
+
+        // Short option values are separate tokens
+        if (strcmp(shape, "long") && token[0] == '-' && !(n & 1)) line[lineCount++] = "42";
+    }
+
+    // First parse builds the index
+    long setupCalls = heapCalls;
+    start = Now();
+    SAH_InitArgs(&parser, lineCount, line, "Parse benchmark");
+    double firstElapsed = Now() - start;
+    setupCalls = heapCalls;
+
+    int repeats = (int) (totalTokens / lineCount) + 1;
+    start = Now();
+    for (int i = 0; i < repeats; i++)
+        SAH_ParseArgs(&parser, lineCount, line);
+    double parseElapsed = Now() - start;
+    long reparseCalls = heapCalls - setupCalls;
+
+    // Name lookups, and getters by name
+    long found = 0;
+    start = Now();
+    for (int i = 0; i < lookups; i++)
+    {
+        int n = (int) ((i * 2654435761u) % (unsigned int) count);
+        found += SearchTable(&parser, (i & 1) ? longNames[n] : shortNames[n]) != NULL;
+    }
+    double lookupElapsed = Now() - start;
+
+    start = Now();
+    for (int i = 0; i < lookups; i++)
+    {
+        int n = (int) ((i * 2654435761u) % (unsigned int) count);
+        const char *key = (i & 1) ? longNames[n] : shortNames[n];
+        found += (n & 1) ? SAH_GetBoolArg(&parser, key) : SAH_HasArg(&parser, key);
+    }
+    double getElapsed = Now() - start;
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    printf("options=%i names=%s shape=%s tokens=%i lazy=%i ns_per_register=%.1f ns_per_token_first=%.1f ns_per_token=%.1f ns_per_search=%.1f ns_per_get=%.1f "
+           "heap_calls_setup=%ld heap_calls_per_parse=%.2f peak_rss_kb=%ld found=%ld\n",
+           count, collide ? "collide" : "spread", shape, lineCount - 1, lazy, registerElapsed / count, firstElapsed / (lineCount - 1),
+           parseElapsed / ((double) repeats * (lineCount - 1)), lookupElapsed / lookups, getElapsed / lookups,
+           setupCalls, (double) reparseCalls / repeats, usage.ru_maxrss, found);
+
+    SAH_FreeArgs(&parser);
+    free(line);
+    return 0;
+}
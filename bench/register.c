@@ -0,0 +1,51 @@
+#include "bench.h"
+
+// Registrations timed per count (best one is reported)
+const int runs = 5;
+
+int main(int argc, const char *argv[])
+{
+    // register.exe [options]: time adding that many options plus a few positionals, then the first parse
+    int count = (argc > 1) ? atoi(argv[1]) : 50000;
+    const char *letters = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    if (count < 1 || count > 200000) return 1;
+
+    // One option per plugin/metric: every name shares a long prefix, positionals share first letters with options
+    static char shortNames[200000][SAH_SHORT_NAME_MAX + 1], longNames[200000][SAH_LONG_NAME_MAX + 1];
+    for (int i = 0; i < count; i++)
+    {
+        sprintf(shortNames[i], "%c%c%c", letters[(i / 3844) % 62], letters[(i / 62) % 62], letters[i % 62]);
+        sprintf(longNames[i], "plugin-metric-%i", i);
+    }
+    const char *line[] = { "register", "input", "output", "--plugin-metric-0" };
+
+    double best = 0, parseBest = 0;
+    long calls = 0;
+    int found = 0;
+    for (int run = 0; run < runs; run++)
+    {
+        SAH_Parser parser = { 0 };
+        long startCalls = heapCalls;
+        double start = Now();
+        SAH_AddPositionalArg(&parser, "input", "Input file", ARG_STRING);
+        SAH_AddPositionalArg(&parser, "output", "Output file", ARG_STRING);
+        for (int i = 0; i < count; i++)
+            SAH_AddOptionalArg(&parser, shortNames[i], longNames[i], "Synthetic option", ARG_BOOL);
+        double elapsed = Now() - start;
+
+        start = Now();
+        SAH_InitArgs(&parser, 4, line, "Registration benchmark");
+        double parseElapsed = Now() - start;
+        calls = heapCalls - startCalls;
+        found += SAH_GetBoolArg(&parser, longNames[count - 1]) + SAH_GetBoolArg(&parser, "plugin-metric-0");
+        SAH_FreeArgs(&parser);
+
+        if (run == 0 || elapsed < best) best = elapsed;
+        if (run == 0 || parseElapsed < parseBest) parseBest = parseElapsed;
+    }
+
+    printf("options=%i us_register=%.1f us_per_thousand=%.1f us_first_parse=%.1f heap_calls=%ld found=%i\n",
+           count, best / 1e3, best / count, parseBest / 1e3, calls, found);
+    return 0;
+}
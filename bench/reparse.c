@@ -0,0 +1,39 @@
+#include "bench.h"
+
+int main(int argc, const char *argv[])
+{
+    // reparse.exe [command lines]: register once, then parse that many command lines with ParseArgs()
+    int count = (argc > 1) ? atoi(argv[1]) : 1000000;
+
+    ArgHandle file = AddPositionalArg("File path", "Path to file", ARG_STRING);
+    ArgHandle number = AddOptionalArg("n", "number", "Show line number", ARG_BOOL);
+    ArgHandle maxLines = AddOptionalArg("l", "max-lines", "Show a specified number of lines", ARG_INT);
+    AddOptionalArg("w", "wait", "Show line at specified interval (second)", ARG_FLOAT);
+    ArgHandle includes = AddOptionalArg("I", "include", "Include directory", ARG_STRING | ARG_LIST);
+
+    // A few different command lines, as a REPL would see them
+    const char *lineA[] = { "repl", "-n", "--max-lines", "25", "input.txt" };
+    const char *lineB[] = { "repl", "-I", "/usr/include", "-I=/opt/include", "-w", "0.5", "other.txt" };
+    const char *lineC[] = { "repl", "--max-lines=7", "third.txt" };
+    const char **lines[] = { lineA, lineB, lineC };
+    int lineCounts[] = { 5, 7, 3 };
+
+    // Warm up (first parse builds the index, lists get their capacity)
+    InitArgs(5, lineA, "Reparse benchmark");
+    ParseArgs(7, lineB);
+    long warmCalls = heapCalls;
+
+    long checksum = 0;
+    double start = Now();
+    for (int i = 0; i < count; i++)
+    {
+        ParseArgs(lineCounts[i % 3], lines[i % 3]);
+        checksum += GetStringArgH(file)[0] + GetBoolArgH(number) + GetArgCountH(includes) + (HasArgH(maxLines) ? GetIntArgH(maxLines) : 0);
+    }
+    double elapsed = Now() - start;
+
+    printf("command_lines=%i checksum=%ld ns_per_parse=%.1f mallocs_after_warmup=%ld\n", count, checksum, elapsed / count, heapCalls - warmCalls);
+
+    FreeArgs();
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include <sys/resource.h>
+#include "bench.h"
+
+// Resident kB of a kind from /proc/self/status ("RssAnon:" is heap and written pages, "RssFile:" clean file pages), -1 if unknown
+static long ResidentKB(const char *kind)
+{
+    FILE *status = fopen("/proc/self/status", "r");
+    if (status == NULL) return -1;
+    char line[256];
+    long kb = -1;
+    while (fgets(line, sizeof(line), status) != NULL)
+        if (!strncmp(line, kind, strlen(kind))) kb = atol(&line[strlen(kind)]);
+    fclose(status);
+    return kb;
+}
+
+int main(int argc, const char *argv[])
+{
+    // response.exe [megabytes] [token length] [nul]: write a response file of repeated "-s value" and parse it
+    size_t megabytes = (argc > 1) ? (size_t) atol(argv[1]) : 16;
+    size_t tokenLength = (argc > 2) ? (size_t) atol(argv[2]) : 16;
+    bool nulDelimited = argc > 3 && !strcmp(argv[3], "nul");
+    const char *path = "response.tmp";
+
+    // Each pair is "-s" and a value of tokenLength characters
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return EXIT_FAILURE;
+    char *value = (char *) malloc(tokenLength + 1);
+    memset(value, 'x', tokenLength);
+    value[tokenLength] = '\0';
+    size_t bytes = 0, pairs = 0;
+    while (bytes < megabytes << 20)
+    {
+        if (nulDelimited) bytes += fprintf(file, "-s%c%s%c", '\0', value, '\0');
+        else bytes += fprintf(file, "-s \"%s\"\n", value);
+        pairs++;
+    }
+    fclose(file);
+    free(value);
+
+    SetResponseFiles(true);
+    AddOptionalArg("s", "string", "Synthetic option", ARG_STRING);
+    const char *fakeArgv[] = { "response", "@response.tmp" };
+
+    double start = Now();
+    InitArgs(2, fakeArgv, "Response file benchmark");
+    double elapsed = Now() - start;
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    printf("mode=%s bytes=%zu tokens=%zu ns_per_byte=%.3f ms_total=%.1f peak_rss_kb=%ld anon_kb=%ld file_kb=%ld\n", nulDelimited ? "nul" : "quoted",
+           bytes, pairs * 2, elapsed / bytes, elapsed / 1e6, usage.ru_maxrss, ResidentKB("RssAnon:"), ResidentKB("RssFile:"));
+
+    FreeArgs();
+    remove(path);
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "bench.h"
+
+// Workers started per run
+const int workers = 1000;
+
+static char shortNames[10000][SAH_SHORT_NAME_MAX + 1], longNames[10000][SAH_LONG_NAME_MAX + 1];
+
+// Every third option is an INT, a STRING or a DOUBLE, plus a positional list of inputs
+static void AddArgs(SAH_Parser *parser, int count)
+{
+    static const int types[] = { ARG_INT, ARG_STRING, ARG_DOUBLE };
+    SAH_AddPositionalArg(parser, "inputs", "Input files", ARG_STRING | ARG_LIST);
+    for (int i = 0; i < count; i++)
+        SAH_AddOptionalArg(parser, shortNames[i], longNames[i], "Synthetic option", types[i % 3]);
+}
+
+int main(int argc, const char *argv[])
+{
+    // snapshot.exe [options]: supervisor parses a value for every option and 100 inputs, then each worker
+    // either parses the forwarded argv again (InitArgs) or loads the supervisor's snapshot (LoadArgs)
+    int count = (argc > 1) ? atoi(argv[1]) : 1000;
+    const char *digits = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+    if (count < 3 || count > 10000) return 1;
+
+    // supervisor /data/input-0 ... /data/input-99 --worker-setting-0 0 --worker-setting-1 value-1 --worker-setting-2 2.25 ...
+    static char inputs[100][32], flags[10000][SAH_LONG_NAME_MAX + 3], values[10000][32];
+    static const char *line[1 + 100 + 2 * 10000];
+    int lineCount = 0;
+    line[lineCount++] = "supervisor";
+    for (int i = 0; i < 100; i++)
+    {
+        sprintf(inputs[i], "/data/input-%i", i);
+        line[lineCount++] = inputs[i];
+    }
+    for (int i = 0; i < count; i++)
+    {
+        sprintf(shortNames[i], "%c%c%c", digits[10 + (i / 1296) % 26], digits[(i / 36) % 36], digits[i % 36]);
+        sprintf(longNames[i], "worker-setting-%i", i);
+        sprintf(flags[i], "--%s", longNames[i]);
+        if (i % 3 == 0) sprintf(values[i], "%i", i * 7);
+        else if (i % 3 == 1) sprintf(values[i], "value-%i", i);
+        else sprintf(values[i], "%i.25", i);
+        line[lineCount++] = flags[i];
+        line[lineCount++] = values[i];
+    }
+
+    SAH_Parser supervisor = { 0 };
+    AddArgs(&supervisor, count);
+    SAH_InitArgs(&supervisor, lineCount, line, "Snapshot benchmark");
+
+    double start = Now();
+    size_t size = SAH_SerializeArgs(&supervisor, NULL, 0);
+    void *snapshot = malloc(size);
+    SAH_SerializeArgs(&supervisor, snapshot, size);
+    double serializeElapsed = Now() - start;
+
+    // Workers: register, then parse or load (registration is the same for both)
+    double registerElapsed = 0, parseElapsed = 0, loadElapsed = 0;
+    long loadCalls = 0;
+    double checksum = 0;
+    for (int w = 0; w < workers; w++)
+    {
+        SAH_Parser parser = { 0 };
+        start = Now();
+        AddArgs(&parser, count);
+        double registered = Now();
+        registerElapsed += registered - start;
+        if (w % 2 == 0)
+        {
+            SAH_InitArgs(&parser, lineCount, line, "Worker");
+            parseElapsed += Now() - registered;
+        }
+        else
+        {
+            long calls = heapCalls;
+            SAH_LoadArgs(&parser, snapshot, size, "Worker");
+            loadElapsed += Now() - registered;
+            loadCalls += heapCalls - calls;
+        }
+        checksum += SAH_GetIntArg(&parser, longNames[0]) + SAH_GetArgCount(&parser, "inputs") + SAH_GetDoubleArg(&parser, longNames[2]);
+        SAH_FreeArgs(&parser);
+    }
+
+    printf("options=%i tokens=%i snapshot_bytes=%zu us_serialize=%.1f us_register=%.1f us_parse=%.1f us_load=%.1f heap_calls_per_load=%.1f checksum=%.0f\n",
+           count, lineCount - 1, size, serializeElapsed / 1e3, registerElapsed / workers / 1e3, parseElapsed / (workers / 2) / 1e3,
+           loadElapsed / (workers / 2) / 1e3, (double) loadCalls / (workers / 2), checksum);
+
+    free(snapshot);
+    SAH_FreeArgs(&supervisor);
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include <sys/resource.h>
+#include "bench.h"
+
+typedef struct Totals
+{
+    long count, bytes;
+    double first;
+} Totals;
+
+static bool Consume(const char *value, size_t length, void *data)
+{
+    Totals *totals = (Totals *) data;
+    (void) value;
+    if (totals->count++ == 0) totals->first = Now();
+    totals->bytes += (long) length + 1;
+    return true;
+}
+
+int main(int argc, const char *argv[])
+{
+    // stream.exe gen [paths] [nul]: write that many paths (newline or NUL separated) for the reading side
+    if (argc > 1 && !strcmp(argv[1], "gen"))
+    {
+        long count = (argc > 2) ? atol(argv[2]) : 1000000;
+        char delimiter = (argc > 3 && !strcmp(argv[3], "nul")) ? '\0' : '\n';
+        for (long i = 0; i < count; i++)
+            printf("/srv/data/project-%ld/src/module-%ld/file-%ld.c%c", i % 97, i % 1009, i, delimiter);
+        return 0;
+    }
+
+    // stream.exe - or stream.exe -0: read the paths from stdin as they arrive
+    double start = Now();
+    AddPositionalArg("paths", "Paths to process", ARG_STRING | ARG_LIST);
+    SetStreamArg("paths");
+    InitArgs(argc, argv, "Streaming benchmark");
+
+    Totals totals = { 0, 0, 0 };
+    ForEachInput(Consume, &totals);
+    double elapsed = Now() - start;
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    printf("mode=%s paths=%ld mb=%.1f us_to_first=%.1f ns_per_path=%.1f mb_per_s=%.0f peak_rss_kb=%ld\n",
+           (argc > 1) ? argv[1] : "args", totals.count, totals.bytes / 1e6, (totals.first - start) / 1e3,
+           elapsed / (totals.count > 0 ? totals.count : 1), totals.bytes / (elapsed / 1e9) / 1e6, usage.ru_maxrss);
+
+    FreeArgs();
+    return 0;
+}
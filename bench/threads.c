@@ -0,0 +1,50 @@
+#include <pthread.h>
+#include "bench.h"
+
+// Command lines parsed by each thread
+static int parsesPerThread = 200000;
+
+static void* Worker(void *result)
+{
+    const char *fakeArgv[] = { "worker", "-n", "--max-lines", "25", "-w=0.5", "--format", "json", "input.txt" };
+    long checksum = 0;
+
+    for (int i = 0; i < parsesPerThread; i++)
+    {
+        // Each command line gets its own parser, nothing is shared between threads
+        SAH_Parser parser = { 0 };
+        SAH_AddPositionalArg(&parser, "File path", "Path to file", ARG_STRING);
+        SAH_AddOptionalArg(&parser, "n", "number", "Show line number", ARG_BOOL);
+        SAH_AddOptionalArg(&parser, "e", "line-end", "Show line end with $", ARG_BOOL);
+        SAH_AddOptionalArg(&parser, "l", "max-lines", "Show a specified number of lines", ARG_INT);
+        SAH_AddOptionalArg(&parser, "w", "wait", "Show line at specified interval (second)", ARG_FLOAT);
+        SAH_AddOptionalArg(&parser, "f", "format", "Output format", ARG_STRING);
+        SAH_InitArgs(&parser, 8, fakeArgv, "Thread benchmark");
+
+        checksum += SAH_GetIntArg(&parser, "max-lines") + SAH_GetBoolArg(&parser, "n") + SAH_GetStringArg(&parser, "format")[0];
+        SAH_FreeArgs(&parser);
+    }
+
+    *(long *) result = checksum;
+    return NULL;
+}
+
+int main(int argc, const char *argv[])
+{
+    // threads.exe [max threads] [parses per thread]: run 1, 2, 4... threads and report total throughput
+    int maxThreads = (argc > 1) ? atoi(argv[1]) : 8;
+    if (argc > 2) parsesPerThread = atoi(argv[2]);
+
+    pthread_t threads[256];
+    long results[256];
+    for (int count = 1; count <= maxThreads && count <= 256; count *= 2)
+    {
+        double start = Now();
+        for (int i = 0; i < count; i++) pthread_create(&threads[i], NULL, Worker, &results[i]);
+        for (int i = 0; i < count; i++) pthread_join(threads[i], NULL);
+        double elapsed = Now() - start;
+
+        printf("threads=%i parses=%i parses_per_sec=%.0f\n", count, count * parsesPerThread, count * parsesPerThread / (elapsed / 1e9));
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "bench.h"
+
+// Number of string options parsed per run
+#define OPTIONS 1000
+
+int main(int argc, const char *argv[])
+{
+    // values.exe [length] [equals]: parse OPTIONS string values of 'length' characters each
+    size_t length = (argc > 1) ? (size_t) atol(argv[1]) : 16;
+    bool useEquals = argc > 2 && !strcmp(argv[2], "equals");
+
+    static char longNames[OPTIONS][SAH_LONG_NAME_MAX + 1], shortNames[OPTIONS][SAH_SHORT_NAME_MAX + 1];
+    static const char *fakeArgv[OPTIONS * 2 + 1];
+    int fakeArgc = 1;
+    fakeArgv[0] = "values";
+
+    for (int i = 0; i < OPTIONS; i++)
+    {
+        sprintf(shortNames[i], "%03i", i);
+        sprintf(longNames[i], "path-%i", i);
+        AddOptionalArg(shortNames[i], longNames[i], "Synthetic option", ARG_STRING);
+
+        // Either "--path-i=xxxx" or "--path-i" "xxxx"
+        char *token = (char *) malloc(length + SAH_LONG_NAME_MAX + 4);
+        int nameEnd = sprintf(token, "--%s%s", longNames[i], useEquals ? "=" : "");
+        memset(token + nameEnd + (useEquals ? 0 : 1), 'x', length);
+        token[nameEnd + (useEquals ? 0 : 1) + length] = '\0';
+        if (useEquals)
+            fakeArgv[fakeArgc++] = token;
+        else
+        {
+            token[nameEnd] = '\0';
+            fakeArgv[fakeArgc++] = token;
+            fakeArgv[fakeArgc++] = token + nameEnd + 1;
+        }
+    }
+
+    double start = Now();
+    InitArgs(fakeArgc, fakeArgv, "String value benchmark");
+    double elapsed = Now() - start;
+
+    // Make sure every value made it through
+    size_t total = 0;
+    for (int i = 0; i < OPTIONS; i++) total += GetStringArg(longNames[i])[length - 1] == 'x';
+
+    printf("length=%zu form=%s values=%zu ns_per_value=%.1f\n", length, useEquals ? "equals" : "separate", total, elapsed / OPTIONS);
+
+    FreeArgs();
+    return 0;
+}
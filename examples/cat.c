@@ -1,12 +1,155 @@
+// splice() and sendfile() are Linux extensions
+#define _GNU_SOURCE
 #include <time.h>
 #include "../simplearghandler.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+    #include <sys/sendfile.h>
+#endif
 
+// Bytes read per call, room in the output buffer
+#define BLOCK_SIZE (1 << 17)
+#define OUTPUT_SIZE (1 << 17)
+
+typedef struct LineState
+{
+    bool showNumber, showLineEnd, lineMax, wait;
+    char endCharacter;
+    int maxLines;
+    float waitTime;
+    // Number of the current line, is the next byte the start of a line?
+    long line;
+    bool lineStart;
+    // Output is collected here and written in big blocks
+    char output[OUTPUT_SIZE];
+    size_t used;
+} LineState;
+
+// Sleep instead of spinning, so waiting doesn't use a core
 void Wait(float waitTime)
 {
-    // Starting time
-    float startTime = (float) clock() / CLOCKS_PER_SEC;
-    // Wait until the current time is greater than start time + wait time
-    while (((float) clock() / CLOCKS_PER_SEC) < startTime + waitTime);
+    struct timespec time = { (time_t) waitTime, (long) ((waitTime - (time_t) waitTime) * 1e9) };
+    while (nanosleep(&time, &time) == -1 && errno == EINTR);
+}
+
+static bool WriteAll(const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = write(STDOUT_FILENO, data, size);
+        if (written < 0 && errno == EINTR) continue;
+        if (written < 0) return false;
+        data += written;
+        size -= (size_t) written;
+    }
+    return true;
+}
+
+static bool Flush(LineState *state)
+{
+    bool ok = WriteAll(state->output, state->used);
+    state->used = 0;
+    return ok;
+}
+
+static bool Emit(LineState *state, const char *data, size_t size)
+{
+    // Long lines go straight out instead of through the buffer
+    if (size > OUTPUT_SIZE / 2) return Flush(state) && WriteAll(data, size);
+    if (state->used + size > OUTPUT_SIZE && !Flush(state)) return false;
+    memcpy(state->output + state->used, data, size);
+    state->used += size;
+    return true;
+}
+
+static bool EmitNumber(LineState *state, long number)
+{
+    // Digits from the end, then a space
+    char text[24];
+    int start = sizeof(text) - 1;
+    text[start] = ' ';
+    do text[--start] = (char) ('0' + number % 10); while ((number /= 10) > 0);
+    return Emit(state, &text[start], sizeof(text) - start);
+}
+
+// Copy data to the output, changing lines as asked (false when done: max lines reached or output failed)
+static bool EmitLines(LineState *state, const char *data, size_t size)
+{
+    const char *end = data + size;
+    while (data < end)
+    {
+        if (state->lineStart && state->showNumber && !EmitNumber(state, state->line)) return false;
+        state->lineStart = false;
+
+        // memchr() is vectorised, so lines are found a block of bytes at a time instead of one by one
+        const char *newline = (const char *) memchr(data, '\n', end - data);
+        if (newline == NULL) return Emit(state, data, end - data);
+
+        if (!Emit(state, data, newline - data)) return false;
+        if (state->showLineEnd && !Emit(state, &state->endCharacter, 1)) return false;
+        if (!Emit(state, "\n", 1)) return false;
+        data = newline + 1;
+        state->lineStart = true;
+        state->line++;
+
+        // Stop at specified max, if allowed
+        if (state->lineMax && state->line > state->maxLines) return false;
+        // Show the line before waiting
+        if (state->wait)
+        {
+            if (!Flush(state)) return false;
+            Wait(state->waitTime);
+        }
+    }
+    return true;
+}
+
+// Whole file mapped if it can be, else read in blocks
+static bool CatLines(LineState *state, int file)
+{
+    struct stat info;
+    bool ok = true;
+    if (fstat(file, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        char *data = (char *) mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED)
+        {
+            madvise(data, (size_t) info.st_size, MADV_SEQUENTIAL);
+            EmitLines(state, data, (size_t) info.st_size);
+            munmap(data, (size_t) info.st_size);
+            return Flush(state);
+        }
+    }
+
+    static char block[BLOCK_SIZE];
+    ssize_t size;
+    while (ok && ((size = read(file, block, sizeof(block))) > 0 || (size < 0 && errno == EINTR)))
+        if (size > 0) ok = EmitLines(state, block, (size_t) size);
+    return Flush(state);
+}
+
+// No line changes: the kernel copies the file to stdout (sendfile() from a regular file, splice() when either side
+// is a pipe), otherwise it's read and written in big blocks
+static bool CatFile(int file)
+{
+    ssize_t size;
+    #ifdef __linux__
+        while ((size = sendfile(STDOUT_FILENO, file, NULL, 1 << 30)) > 0);
+        if (size == 0) return true;
+        if (errno != EINVAL && errno != ENOSYS) return false;
+
+        while ((size = splice(file, NULL, STDOUT_FILENO, NULL, 1 << 30, SPLICE_F_MOVE)) > 0);
+        if (size == 0) return true;
+        if (errno != EINVAL && errno != ENOSYS) return false;
+    #endif
+
+    static char block[BLOCK_SIZE];
+    while ((size = read(file, block, sizeof(block))) > 0 || (size < 0 && errno == EINTR))
+        if (size > 0 && !WriteAll(block, (size_t) size)) return false;
+    return size == 0;
 }
 
 int main(int argc, const char *argv[])
@@ -20,49 +163,39 @@ int main(int argc, const char *argv[])
     InitArgs(argc, argv, "Concatenate a file to standard output");
 
     const char *filePath = GetStringArg("File path");
-    FILE *fileToPrint = fopen(filePath, "r");
-    if (fileToPrint != NULL)
+    int file = open(filePath, O_RDONLY);
+    bool ok = true;
+    if (file >= 0)
     {
-        bool showNumber = GetBoolArg("n"), showLineEnd = GetBoolArg("e");
-        bool lineMax = HasArg("max-lines"), wait = HasArg("w");
-        int ch, n = 1, maxLines = 0, endCharacter = '$';
-        float waitTime = 0.0f;
+        static LineState state;
+        state.showNumber = GetBoolArg("n");
+        state.showLineEnd = GetBoolArg("e");
+        state.lineMax = HasArg("max-lines");
+        state.wait = HasArg("w");
+        state.endCharacter = '$';
+        state.line = 1;
+        state.lineStart = true;
 
-        if (lineMax) maxLines = GetIntArg("max-lines");
-        if (wait) waitTime = GetFloatArg("w");
+        if (state.lineMax) state.maxLines = GetIntArg("max-lines");
+        if (state.wait) state.waitTime = GetFloatArg("w");
         if (HasArg("ec"))
         {
-            showLineEnd = true;
-            endCharacter = GetCharArg("ec");
+            state.showLineEnd = true;
+            state.endCharacter = GetCharArg("ec");
         }
-        
-        // Show first line number
-        if (showNumber) printf("%i ", n);
-        // While character is not end of line character
-        while ((ch = fgetc(fileToPrint)) != EOF)
+
+        // Lines only have to be looked at if something changes them (or counts them)
+        if (state.showNumber || state.showLineEnd || state.lineMax || state.wait)
         {
-            // If new line character
-            if (ch == '\n')
-            {
-                // Increment line count
-                n++;
-                // Show character at line end
-                if (showLineEnd) printf("%c", endCharacter);
-            }
-            // Print character
-            printf("%c", ch);
-            // Stop at specified max
-            if (lineMax && n > maxLines) break;
-            // Show line number at the beginning of a new line, if allowed
-            if (ch == '\n' && showNumber) printf("%i ", n);
-            // If wait is allowed and new line, wait for specified amount of time
-            if (wait && ch == '\n') Wait(waitTime);
+            if (!state.lineMax || state.maxLines > 0) ok = CatLines(&state, file);
         }
-        fclose(fileToPrint);
+        else
+            ok = CatFile(file);
+        close(file);
     }
-    else 
-        printf("cat: %s: No such file or directory\n", filePath);
+    else
+        printf("cat: %s: %s\n", filePath, strerror(errno));
 
     FreeArgs();
-    return 0;
-}
\ No newline at end of file
+    return (file >= 0 && ok) ? 0 : 1;
+}
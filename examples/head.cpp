@@ -0,0 +1,32 @@
+#include <cstdio>
+#include "../simplearghandler.hpp"
+
+// Same parsing as cat.c, but the args are checked by the compiler and read without a lookup
+using HeadArgs = sah::Args<sah::Positional<"File path", "Path to file", const char*>,
+                           sah::Optional<"n", "lines", "Number of lines to show (default 10)", int>,
+                           sah::Optional<"q", "quiet", "Don't show the file name", bool>>;
+
+int main(int argc, const char *argv[])
+{
+    HeadArgs args(argc, argv, "Output the first part of a file");
+
+    const char *filePath = args.get<"File path">();
+    FILE *fileToPrint = fopen(filePath, "r");
+    if (fileToPrint != NULL)
+    {
+        int ch, n = 0, maxLines = args.has<"n">() ? args.get<"lines">() : 10;
+
+        if (!args.get<"quiet">()) printf("==> %s <==\n", filePath);
+        // Print characters until the max line count is reached
+        while (n < maxLines && (ch = fgetc(fileToPrint)) != EOF)
+        {
+            putchar(ch);
+            if (ch == '\n') n++;
+        }
+        fclose(fileToPrint);
+    }
+    else
+        printf("head: %s: No such file or directory\n", filePath);
+
+    return 0;
+}
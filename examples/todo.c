@@ -1,34 +1,230 @@
 #include "../simplearghandler.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
-const int stringMax = 100;
+// Every change is one line appended to the log, so nothing is rewritten until it's compacted:
+//   +text  add    *text  add, already done (written by compaction)    d<id>  done    r<id>  remove
+// (id: which add it was, counting from 0)
+const char *logPath = "todo.log", *compactPath = "todo.log.tmp";
+// Older versions kept one todo per line here, with " (done)" on the end of done ones
+const char *oldPath = "todo.txt";
+// Compact once dead records (removed todos, done and remove records) outnumber live todos and there are at least this many
+const long compactMin = 1024;
 
-int TextToArray(FILE *textFile, char array[stringMax][stringMax])
+typedef struct Todo
 {
-    int lastLine = 0;
-    // If textFile is available
-    if (textFile != NULL)
+    // Text in the mapped log (not '\0' terminated), its length
+    const char *text;
+    size_t length;
+    bool done, removed;
+} Todo;
+
+typedef struct TodoList
+{
+    // Every add in the log in order (grows by doubling), count, room
+    Todo *todos;
+    long count, capacity;
+    // Todos not removed, records compaction would drop
+    long live, dead;
+    // Mapped log, its size
+    char *data;
+    size_t size;
+} TodoList;
+
+static bool WriteAll(int file, const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = write(file, data, size);
+        if (written < 0 && errno == EINTR) continue;
+        if (written < 0) return false;
+        data += written;
+        size -= (size_t) written;
+    }
+    return true;
+}
+
+static void AddTodo(TodoList *list, const char *text, size_t length, bool done)
+{
+    if (list->count == list->capacity)
     {
-        char line[stringMax];
-        // Read a line, make sure the line isn't empty
-        while(fgets(line, stringMax, textFile) != NULL && line[0] != '\0')
+        list->capacity = (list->capacity > 0) ? list->capacity * 2 : 64;
+        list->todos = (Todo *) realloc(list->todos, list->capacity * sizeof(Todo));
+        if (list->todos == NULL)
         {
-            // Check if line contains a new character
-            char *newLine = strchr(line, '\n');
-            // If it does
-            if (newLine != NULL)
+            printf("Out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    list->todos[list->count++] = (Todo) { text, length, done, false };
+    list->live++;
+}
+
+// Map the log and replay it (a missing log is an empty list)
+static void LoadTodos(TodoList *list)
+{
+    int file = open(logPath, O_RDONLY);
+    struct stat info;
+    if (file < 0) return;
+    if (fstat(file, &info) == 0 && info.st_size > 0)
+    {
+        list->size = (size_t) info.st_size;
+        list->data = (char *) mmap(NULL, list->size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (list->data == MAP_FAILED)
+        {
+            printf("Can't read %s\n", logPath);
+            exit(EXIT_FAILURE);
+        }
+    }
+    close(file);
+
+    const char *line = list->data, *end = list->data + list->size;
+    while (line < end)
+    {
+        // Last line may have no newline (e.g. if a write was cut short)
+        const char *lineEnd = (const char *) memchr(line, '\n', end - line);
+        if (lineEnd == NULL) lineEnd = end;
+
+        if (line[0] == '+' || line[0] == '*')
+            AddTodo(list, line + 1, lineEnd - line - 1, line[0] == '*');
+        else if (line[0] == 'd' || line[0] == 'r')
+        {
+            long id = 0;
+            for (const char *digit = line + 1; digit < lineEnd && *digit >= '0' && *digit <= '9'; digit++)
+                id = id * 10 + (*digit - '0');
+
+            list->dead++;
+            if (id < list->count && !list->todos[id].removed)
             {
-                // Get the index in string (e.g 0x05 - 0x01, index of new line is 4)
-                int newLineIndex = (int) (newLine - line);
-                // Remove new line, by ending the string there
-                line[newLineIndex] = '\0';
+                if (line[0] == 'd') list->todos[id].done = true;
+                else
+                {
+                    list->todos[id].removed = true;
+                    list->live--;
+                    list->dead++;
+                }
             }
-            // Copy line to array
-            strcpy(array[lastLine++], line);
         }
-        // When done, close file
-        fclose(textFile);
+        line = lineEnd + 1;
+    }
+}
+
+// Id of the todo shown as number index (-1 if there isn't one)
+static long FindTodo(TodoList *list, int index)
+{
+    if (index <= 0 || index > list->live) return -1;
+    for (long id = 0; id < list->count; id++)
+        if (!list->todos[id].removed && --index == 0) return id;
+    return -1;
+}
+
+// One write to the end of the log
+static bool AppendRecord(const char *record, size_t length)
+{
+    int file = open(logPath, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (file < 0) return false;
+    bool ok = WriteAll(file, record, length);
+    return close(file) == 0 && ok;
+}
+
+// Write only the live todos to a new log, then swap it in (the old log stays whole if anything fails)
+static bool CompactTodos(TodoList *list)
+{
+    int file = open(compactPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) return false;
+
+    static char buffer[1 << 16];
+    size_t used = 0;
+    bool ok = true;
+    for (long id = 0; ok && id < list->count; id++)
+    {
+        Todo *todo = &list->todos[id];
+        if (todo->removed) continue;
+        if (used + todo->length + 2 > sizeof(buffer))
+        {
+            ok = WriteAll(file, buffer, used);
+            used = 0;
+        }
+
+        // Longer than the buffer: marker and text go out on their own
+        if (todo->length + 2 > sizeof(buffer))
+        {
+            ok = ok && WriteAll(file, todo->done ? "*" : "+", 1) && WriteAll(file, todo->text, todo->length) && WriteAll(file, "\n", 1);
+            continue;
+        }
+        buffer[used++] = todo->done ? '*' : '+';
+        memcpy(buffer + used, todo->text, todo->length);
+        used += todo->length;
+        buffer[used++] = '\n';
+    }
+    ok = ok && WriteAll(file, buffer, used);
+
+    if (close(file) != 0 || !ok || rename(compactPath, logPath) != 0)
+    {
+        remove(compactPath);
+        return false;
+    }
+    list->dead = 0;
+    return true;
+}
+
+// First run without a log: write one from the old todo list (through compactPath, so it's all or nothing)
+static void ImportOldTodos(void)
+{
+    if (access(logPath, F_OK) == 0) return;
+    FILE *oldFile = fopen(oldPath, "r");
+    if (oldFile == NULL) return;
+    FILE *file = fopen(compactPath, "w");
+
+    char *line = NULL;
+    size_t capacity = 0;
+    ssize_t length;
+    long count = 0;
+    const size_t doneLength = strlen(" (done)");
+    while (file != NULL && (length = getline(&line, &capacity, oldFile)) >= 0)
+    {
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) length--;
+        // Removed todos were left as empty lines
+        if (length == 0) continue;
+        bool done = (size_t) length > doneLength && !memcmp(line + length - doneLength, " (done)", doneLength);
+        if (done) length -= doneLength;
+        fprintf(file, "%c%.*s\n", done ? '*' : '+', (int) length, line);
+        count++;
+    }
+    free(line);
+    fclose(oldFile);
+
+    if (file == NULL || ferror(file) | fclose(file) || rename(compactPath, logPath) != 0)
+    {
+        remove(compactPath);
+        printf("Can't import %s into %s\n", oldPath, logPath);
+        return;
     }
-    return lastLine;
+    printf("Imported %ld todo%s from %s into %s\n", count, (count == 1) ? "" : "s", oldPath, logPath);
+}
+
+static void PrintTodos(TodoList *list)
+{
+    if (list->live == 0)
+    {
+        printf("Todo list empty, add a todo with -a/--add \"todo\"\n");
+        return;
+    }
+
+    // Large output buffer, so a long list isn't one write per line
+    static char buffer[1 << 16];
+    setvbuf(stdout, buffer, _IOFBF, sizeof(buffer));
+    for (long id = 0, n = 1; id < list->count; id++)
+    {
+        Todo *todo = &list->todos[id];
+        if (todo->removed) continue;
+        printf("%ld. ", n++);
+        fwrite(todo->text, 1, todo->length, stdout);
+        printf("%s\n", todo->done ? " (done)" : "");
+    }
+    fflush(stdout);
 }
 
 int main(int argc, const char *argv[])
@@ -37,91 +233,100 @@ int main(int argc, const char *argv[])
     AddOptionalArg("r", "remove", "Remove a todo (by index)", ARG_INT);
     AddOptionalArg("d", "done", "Todo done (by index)", ARG_INT);
     AddOptionalArg("c", "clear", "Clear all todos", ARG_BOOL);
-    InitArgs(argc, argv, "Todo list");
+    InitArgs(argc, argv, "Todo list in todo.log (adding appends, done/remove/list read the whole log)");
+    ImportOldTodos();
 
-    char todos[stringMax][stringMax];
-    // Set todos array from file and get last line
-    int lastLine = TextToArray(fopen("todo.txt", "r"), todos);
+    // If add flag used, append it to the log (the log isn't read at all)
+    if (HasArg("add"))
+    {
+        const char *text = GetStringArg("add");
+        size_t length = strlen(text);
+        char *record = (char *) malloc(length + 2);
+        if (record == NULL)
+        {
+            printf("Out of memory\n");
+            FreeArgs();
+            return EXIT_FAILURE;
+        }
 
-    // Open file for writing
-    FILE *todoList = fopen("todo.txt", "w");
-    if (todoList == NULL)
+        // One todo is one line
+        record[0] = '+';
+        for (size_t i = 0; i < length; i++) record[i + 1] = (text[i] == '\n' || text[i] == '\r') ? ' ' : text[i];
+        record[length + 1] = '\n';
+        bool ok = AppendRecord(record, length + 2);
+        if (ok) printf("Added: %.*s", (int) length + 1, record + 1);
+        else printf("Can't write %s\n", logPath);
+        free(record);
+        FreeArgs();
+        return ok ? 0 : EXIT_FAILURE;
+    }
+
+    // If clear flag used, start a new log
+    if (GetBoolArg("clear"))
     {
-        printf("Insufficient space\n");
-        return EXIT_FAILURE;
+        int file = open(logPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (file >= 0) close(file);
+        printf("Todo list empty, add a todo with -a/--add \"todo\"\n");
+        FreeArgs();
+        return (file >= 0) ? 0 : EXIT_FAILURE;
     }
 
-    // If add flag used, add given string to array
-    if (HasArg("add"))
-        strcpy(todos[lastLine++], GetStringArg("add"));
+    TodoList list = { 0 };
+    LoadTodos(&list);
 
-    // If remove flag used, remove string by index from array
-    else if (HasArg("remove"))
+    // If remove or done flag used, append a record for it
+    if (HasArg("remove") || HasArg("done"))
     {
-        int removeIndex = GetIntArg("remove");
+        bool removing = HasArg("remove");
+        int index = removing ? GetIntArg("remove") : GetIntArg("done");
+        long id = FindTodo(&list, index);
         // Make sure index is within bounds
-        if (removeIndex <= 0 || removeIndex > lastLine)
+        if (id < 0)
         {
             printf("Invalid index\n");
             FreeArgs();
             return EXIT_FAILURE;
         }
-        // Remove from array, by setting is empty
-        strcpy(todos[removeIndex - 1], "");
-    }
 
-    // If done flag used, concatenate ' (done)' to line
-    else if (HasArg("d"))
-    {
-        int doneIndex = GetIntArg("done");
-        // Make sure index is within bounds
-        if (doneIndex <= 0 || doneIndex > lastLine)
+        Todo *todo = &list.todos[id];
+        char record[32];
+        int length = sprintf(record, "%c%ld\n", removing ? 'r' : 'd', id);
+        // Already done: nothing to write
+        if ((removing || !todo->done) && !AppendRecord(record, (size_t) length))
         {
-            printf("Invalid index\n");
+            printf("Can't write %s\n", logPath);
             FreeArgs();
             return EXIT_FAILURE;
         }
-        // Check if done has already been added
-        if (strstr(todos[doneIndex - 1], " (done)") == NULL)
-            // If not add ' (done)'
-            strcat(todos[doneIndex - 1], " (done)");
-    }
 
-    // If clear flag used
-    else if (GetBoolArg("clear"))
-    {
-        lastLine = 1;
-        strcpy(todos[0], "");
-    }
+        printf("%s %i. %.*s\n", removing ? "Removed" : "Done:", index, (int) todo->length, todo->text);
+        if (removing)
+        {
+            todo->removed = true;
+            list.live--;
+            list.dead += 2;
+        }
+        else if (!todo->done)
+        {
+            todo->done = true;
+            list.dead++;
+        }
 
-    // If todo empty, or cleared ^^
-    if (lastLine == 0 || todos[0][0] == '\0')
-    {
-        // Print message
-        printf("Todo list empty, add a todo with -a/--add \"todo\"\n");
-        // Print nothing to text
-        fprintf(todoList, "%s", todos[0]);
+        // Log is mostly dead records, write it again with just the todos
+        if (list.dead >= compactMin && list.dead > list.live && !CompactTodos(&list))
+            printf("Can't compact %s\n", logPath);
     }
-
-    // If not empty
+    // Nothing to change, list them
     else
     {
-        // Go through each line (in array)
-        for (int i = 0, n = 1; i < lastLine; i++)
-        {
-            // If current line is not empty
-            if (todos[i][0] != '\0')
-            {
-                // Print todo with number to stdout
-                printf("%i. %s\n", n++, todos[i]);
-                // Print todo to file
-                fprintf(todoList, "%s", todos[i]);
-                // Add a new line for lines that are not the last line
-                if (i < (lastLine - 1)) fprintf(todoList, "\n");
-            }
-        }
+        PrintTodos(&list);
+        // Adds alone never reach the check above, so a log only appended to is compacted here
+        if (list.dead >= compactMin && list.dead > list.live && !CompactTodos(&list))
+            printf("Can't compact %s\n", logPath);
     }
 
+    if (list.data != NULL) munmap(list.data, list.size);
+    free(list.todos);
     FreeArgs();
     return 0;
-}
\ No newline at end of file
+}
@@ -6,86 +6,525 @@
     #include <stdbool.h>
     #include <string.h>
     #include <ctype.h>
+    #include <stdint.h>
+    #include <limits.h>
+    #include <float.h>
+    #include <errno.h>
+    #include <locale.h>
+    #include <math.h>
+    #include <stdarg.h>
+    #include <setjmp.h>
+
+    // Response files are memory mapped where mmap is available
+    #if defined(__unix__) || defined(__APPLE__)
+        #define SAH_USE_MMAP
+        #include <sys/mman.h>
+        #include <sys/stat.h>
+        #include <fcntl.h>
+        #include <unistd.h>
+    #endif
 
-    // Arg hash table max (numbers + letters)
-    #define SAH_MAX_ARGS 10 + 26
     // Short arg name max e.g. vEt
     #define SAH_SHORT_NAME_MAX 3
     // Long arg name max e.g. ilovecodingincandcppppppp
     #define SAH_LONG_NAME_MAX 25
-    // Max characters for string value
+    // Max characters for help text, app name and description
     #define SAH_STRING_MAX 100
+    // Lookup index slots per registered name (keeps the load factor at or below 1/2)
+    #define SAH_INDEX_LOAD 2
+    // Size of each heap block the arena grabs (bigger requests get a block of their own)
+    #define SAH_BLOCK_SIZE 4096
+    // Alignment of every arena allocation
+    #define SAH_ALIGN (sizeof(void *) * 2)
+    // Starting size of the buffer stdin values are read into (doubles if one value doesn't fit)
+    #define SAH_STREAM_BUFFER 65536
+    // First bytes of a SerializeArgs() snapshot ("SAHS"), bumped when its layout changes
+    #define SAH_SNAPSHOT_MAGIC 0x53484153u
+    #define SAH_SNAPSHOT_VERSION 1
+    // FreezeArgs() blocks and each array in them start on a new cache line
+    #define SAH_CACHE_LINE 64
+
+    // Define SAH_STATS before including this file to count lookups and allocations and time each parsing phase
+    // (read with GetArgStats(), or run the app with the SAH_STATS environment variable set to print them after parsing)
+    #ifdef SAH_STATS
+        #include <time.h>
+        #define SAH_Count(parser, counter, amount) ((parser)->stats.counter += (amount))
+        #define SAH_TimeStart(start) uint64_t start = StatsNow()
+        #define SAH_TimeEnd(parser, counter, start) ((parser)->stats.counter += StatsNow() - (start))
+    #else
+        #define SAH_Count(parser, counter, amount) ((void) 0)
+        #define SAH_TimeStart(start)
+        #define SAH_TimeEnd(parser, counter, start) ((void) 0)
+    #endif
 
-    // Return index in hash table (for digits return 0 - 9, for letters return 10 - 36)
-    #define SAH_GetTableIndex(key) (isdigit(key) ? (key - '0') : ((tolower(key) - 'a') + 10))
-    // Allocate memory of 'size' to ptr of 'type' and assign 'value' to it
-    #define SAH_Alloc(type, ptr, size, value) type *ptr = (type *) malloc(size);\
-                                            if (ptr != NULL) *ptr = value;\
-                                            else PrintAndQuit("simplearghandler: Error: Memory allocation failed :(")
-
-    // Is InitArgs() called?
-    static bool initialised = false;
+    // Supported types
+    enum { ARG_INT, ARG_BOOL, ARG_CHAR, ARG_FLOAT, ARG_STRING, ARG_INT64, ARG_UINT64, ARG_DOUBLE, ARG_CHOICE };
+    // Type names used in error messages (same order as enum)
+    static const char *argTypeNames[] = { "INT", "BOOL", "CHAR", "FLOAT", "STRING/CHAR*", "INT64", "UINT64", "DOUBLE", "CHOICE" };
+
+    // Or with a type (e.g. ARG_STRING | ARG_LIST) to collect every value given instead of just one
+    // A positional list takes all remaining positional values, so it has to be the last positional arg
+    #define ARG_LIST 0x100
+    // ARG_COUNT (an ARG_INT) takes no value and counts how many times it's given, e.g. -vvv is 3 (0 if it isn't given)
+    #define ARG_COUNT 0x200
+
+    // Results of number parsing
+    enum { SAH_NUMBER_OK, SAH_NUMBER_INVALID, SAH_NUMBER_RANGE };
+
+    // Error codes returned by TryParseArgs()/TryInitArgs() and GetArgError()
+    // Command line mistakes (HELP to COMMAND) are followed by usage when printed
+    enum
+    {
+        SAH_OK,
+        SAH_ERROR_HELP, SAH_ERROR_UNKNOWN_ARG, SAH_ERROR_MISSING_VALUE, SAH_ERROR_INVALID_VALUE, SAH_ERROR_RANGE, SAH_ERROR_REQUIRED, SAH_ERROR_COMMAND,
+        SAH_ERROR_FILE, SAH_ERROR_NOT_FOUND, SAH_ERROR_TYPE, SAH_ERROR_NOT_PARSED, SAH_ERROR_USAGE, SAH_ERROR_MEMORY
+    };
 
-    static char appName[SAH_STRING_MAX + 1] = "app", appDesc[SAH_STRING_MAX + 1] = "Terminal app";
-    // Names of positional arguments in the correct order
-    static char positionalArgNames[SAH_MAX_ARGS][SAH_LONG_NAME_MAX + 1];
+    // Returned by AddOptionalArg()/AddPositionalArg(), used with Get*ArgH() to skip name lookups
+    typedef int ArgHandle;
 
-    // Array of used indexes
-    static int indexesUsed[SAH_MAX_ARGS];
-    // Count of used indexes, count of positional arguments
-    static int usedCount = 0, positionalCount = 0;
+    union ArgItem;
+    // Called from the parse loop with every value of an arg, already converted (see SetArgAction())
+    typedef void (*SAH_ArgAction)(ArgHandle handle, union ArgItem value, void *data);
 
-    // Supported types
-    enum { ARG_INT, ARG_BOOL, ARG_CHAR, ARG_FLOAT, ARG_STRING };
+    // One value of a list (text: STRING/CHAR, i: INT/INT64/CHOICE, u: UINT64, d: FLOAT/DOUBLE)
+    typedef union ArgItem
+    {
+        const char *text;
+        int64_t i;
+        uint64_t u;
+        double d;
+    } ArgItem;
 
     typedef struct Arg
     {
         // shortName: h, longName: help, help: "Text to show in help mode"
         char shortName[SAH_SHORT_NAME_MAX + 1], longName[SAH_LONG_NAME_MAX + 1], help[SAH_STRING_MAX + 1];
-        // Pointer to value
+        // Pointer to value (for strings and chars this points into argv and isn't owned, for numbers to 'number')
         void *value;
+        // Copy of a value whose token doesn't last (see KeepText()), its size
+        char *kept;
+        size_t keptSize;
+        // Numbers are stored inline (i: INT/INT64 and the index of a CHOICE, u: UINT64, d: FLOAT/DOUBLE)
+        ArgItem number;
+        // Lazy mode: token not converted yet (converted on first access, then NULL)
+        const char *raw;
+        // List args: values in order (grows by doubling), count, capacity
+        ArgItem *items;
+        int itemCount, itemCapacity;
+        bool list;
+        // ARG_COUNT: number stays 'value' and goes up by one each time
+        bool count;
+        // Gets each value instead of it being stored (NULL to store it), its data
+        SAH_ArgAction action;
+        void *actionData;
+        // ARG_CHOICE: allowed values, them as "a|b|c" (for help and errors), count,
+        // hash slots holding index + 1 (0: empty), number of slots - 1
+        const char **choices;
+        const char *choiceText;
+        int choiceCount;
+        int *choiceSlots;
+        unsigned int choiceMask;
         // Type from enum
         int argType;
         // optional or positional
         bool optional;
-        // Chaining
-        struct Arg *next;
+        // Registration order, used as handle
+        ArgHandle handle;
+        // ARG_BOOL: bit in the parser's boolBits
+        int bit;
     } Arg;
 
-    // Hash table for all arguments
-    static Arg *args[SAH_MAX_ARGS];
+    typedef struct ArgIndexSlot
+    {
+        // Full hash of name, name (points into arg), arg it belongs to (NULL if slot is empty)
+        unsigned int hash;
+        const char *name;
+        Arg *arg;
+    } ArgIndexSlot;
 
-    void FreeArgs(void)
+    typedef struct ArgTrieNode
+    {
+        // Character leading to this node, length of its prefix, number of children
+        unsigned char ch, depth;
+        unsigned short childCount;
+        // Children sit next to each other in the node array, sorted by character
+        int firstChild;
+        // Long names starting with this node's prefix are trieArgs[start] to trieArgs[end - 1]
+        int start, end;
+    } ArgTrieNode;
+
+    typedef struct ArgBlock
+    {
+        // Next (older) block, bytes usable after the header, bytes handed out
+        struct ArgBlock *next;
+        size_t size, used;
+    } ArgBlock;
+
+    // Size of block header, rounded up so data after it stays aligned
+    #define SAH_BLOCK_HEADER ((sizeof(ArgBlock) + SAH_ALIGN - 1) / SAH_ALIGN * SAH_ALIGN)
+
+    typedef struct ArgFile
+    {
+        // Next file, file contents (read only, followed by at least one zero byte), size of mapping/buffer
+        struct ArgFile *next;
+        const char *data;
+        size_t size;
+        // Its tokens in the expanded command line (first index, count), are they quoted (not NUL delimited, see Token())
+        int first, count;
+        bool quoted;
+    } ArgFile;
+
+    struct SAH_Parser;
+    // Registers a command's args on the parser it gets, only called if that command is selected
+    typedef void (*SAH_CommandSetup)(struct SAH_Parser *parser);
+
+    // Gets each value of the stream arg (see ForEachInput()), return false to stop
+    typedef bool (*SAH_InputCallback)(const char *value, size_t length, void *data);
+
+    typedef struct ArgCommand
+    {
+        // Name typed after the app name, text shown in help (and as the description of the command's own help)
+        char name[SAH_LONG_NAME_MAX + 1], help[SAH_STRING_MAX + 1];
+        SAH_CommandSetup setup;
+        // Next command, in the order they were added
+        struct ArgCommand *next;
+    } ArgCommand;
+
+    typedef struct ArgSnapshotHeader
+    {
+        // SAH_SNAPSHOT_MAGIC, SAH_SNAPSHOT_VERSION, bytes in the snapshot, SchemaHash() of the parser that wrote it
+        uint32_t magic, version, size, schema;
+        // Number of args and bools, offsets of the app name and the selected command's name ("" if none)
+        uint32_t argCount, boolCount, appName, command;
+    } ArgSnapshotHeader;
+
+    typedef struct ArgSnapshotEntry
+    {
+        // Values given (0: not set, 1 unless it's a list), unused
+        uint32_t count, reserved;
+        // Number bits, offset of the string, or offset of a list's items (numbers or string offsets)
+        uint64_t value;
+    } ArgSnapshotEntry;
+
+    // Read only copy of every parsed value (see FreezeArgs()), in one cache line aligned block, read with SAH_Frozen*()
+    typedef struct SAH_FrozenArgs
     {
-        // Go through all assigned/used arguments
-        for (int i = 0; i < usedCount; i++)
+        // Value by handle (number, text of a STRING/CHAR, index of a CHOICE or -1, ARG_COUNT's count, start of a list in items)
+        const ArgItem *values;
+        // Bit per handle, set if the arg was given (for bools: if it's true)
+        const uint64_t *present;
+        // Values given by handle (lists only, 0 for other args), every list's values one after another
+        const int *itemCounts;
+        const ArgItem *items;
+        // Number of args, allocation to free (the block starts inside it)
+        int argCount;
+        void *allocation;
+    } SAH_FrozenArgs;
+
+    #ifdef SAH_STATS
+        typedef struct SAH_ArgStats
         {
-            // Pointer to current arg, pointer to next arg
-            Arg *current = args[indexesUsed[i]], *next = args[indexesUsed[i]];
-            while (current != NULL)
-            {
-                // Save address of next arg
-                next = current->next;
-                // If value is not empty, free it
-                if (current->value != NULL)
-                    free(current->value);
-                // Free current arg
-                free(current);
+            // Name lookups, index slots looked at
+            long lookups, probes;
+            // Index slots looked at when registering (checking for duplicates), index rebuilds as it grows
+            long duplicateChecks, indexGrows;
+            // Heap calls (malloc, realloc, mmap) and bytes asked for
+            long allocations, allocatedBytes;
+            // Calls to ParseArgs(), tokens parsed (after response files)
+            long parses, tokens;
+            // Nanoseconds spent adding args (including indexing them), expanding response files and parsing (summed over all parses)
+            uint64_t registerTime, responseTime, parseTime;
+        } SAH_ArgStats;
+    #endif
+
+    // Everything a parser owns, so parsers don't share any state (zero initialise before use: SAH_Parser parser = { 0 };)
+    // The registered args and the results of the last parse are kept together, and parsing, and even reading values, can
+    // write to it (token array, trie, bool bits, lazy values, error codes). So a parser must never be used by two threads at
+    // once, not even for reads while another thread parses: give each thread its own parser (adding args is O(1) each),
+    // or parse once and share a SAH_FreezeArgs() snapshot
+    typedef struct SAH_Parser
+    {
+        // Is InitArgs() called?
+        bool initialised;
+
+        char appName[SAH_STRING_MAX + 1], appDesc[SAH_STRING_MAX + 1];
+        // Is registration over? (set by the first parse, which adds --help, even if it fails: nothing can be added after it)
+        bool registered;
+
+        // Args by handle, i.e. in the order they were added (grows by doubling), count of all registered arguments, room
+        Arg **argHandles;
+        int argCount, argCapacity;
+        // Positional arguments in the correct order (grows by doubling), count, room
+        Arg **positionalArgs;
+        int positionalCount, positionalCapacity;
+
+        // Open-addressed lookup index over every short and long name (grows with registration, also catches duplicates)
+        ArgIndexSlot *argIndex;
+        // Number of slots in argIndex (always a power of two)
+        unsigned int argIndexSize;
+        // Positional list arg, if any
+        Arg *variadicArg;
+        // Every ARG_BOOL is one bit (allocated when registration ends), count of bool args
+        uint64_t *boolBits;
+        int boolCount;
+        // Prefix trie over long names (built on the first abbreviation or completion, node 0 is the root), long names sorted
+        ArgTrieNode *trie;
+        Arg **trieArgs;
+
+        // Bump allocator holding every Arg, value and the lookup index (newest block first)
+        ArgBlock *arena;
+        // Caller supplied block from SetArgBuffer() (never freed)
+        ArgBlock *userBlock;
+
+        // Expand @file arguments (see SetResponseFiles()), response files kept until the next parse since values point into them
+        bool responseFiles;
+        ArgFile *argFiles;
+        // argv without the command token (see SelectCommand())
+        const char **argTokens;
+        int tokenCount, tokenCapacity;
+        // argv with response files expanded, each token where it starts (0 tokens if there were none), capacity
+        const char **fileTokens;
+        int fileTokenCount, fileTokenCapacity;
+        // Quoted response file tokens are unquoted into these when parsed (token i into buffer i % 2, so the parse loop can
+        // look one token ahead), their sizes, the token in each (-1: none)
+        char *unquoted[2];
+        size_t unquotedSize[2];
+        int unquotedToken[2];
+        // Copies of list values from unquoted tokens (see KeepText()), kept until the next parse
+        ArgBlock *keptText;
+
+        // Convert values on first access instead of while parsing (see SetLazyArgs())
+        bool lazy;
+        // Answer --complete in InitArgs() (see SetCompletion())
+        bool completion;
+
+        // Positional list that can be read from stdin (see SetStreamArg()), its -0/--stdin0 flag, next list value to give out
+        Arg *streamArg, *stdinArg;
+        int streamItem;
+        // Reusable stdin buffer (values point into it), its size, bytes read, start of the next value
+        char *streamBuffer;
+        size_t streamSize, streamUsed, streamStart;
+        // Reading stdin now, stdin hit end of file, stdin already used up, character between values
+        bool streaming, streamEnd, streamDone;
+        char streamDelimiter;
+
+        // Subcommands (in the arena), selected command (NULL until parsed)
+        ArgCommand *commands, *command;
+        // Args added before the command was picked (the global ones, first in argHandles)
+        int globalCount;
+
+        // Non-fatal errors: message buffer (see SetErrorBuffer()), where TryParseArgs() returns to, last error code
+        char *errorBuffer;
+        size_t errorSize;
+        bool nonFatal;
+        jmp_buf *errorJump;
+        int error;
+
+        #ifdef SAH_STATS
+            SAH_ArgStats stats;
+        #endif
+    } SAH_Parser;
+
+    // Parser used by the functions without a parser argument
+    static SAH_Parser sahDefaultParser;
+
+    #ifdef SAH_STATS
+        static uint64_t StatsNow(void)
+        {
+            struct timespec ts;
+            #if defined(__unix__) || defined(__APPLE__)
+                clock_gettime(CLOCK_MONOTONIC, &ts);
+            #else
+                timespec_get(&ts, TIME_UTC);
+            #endif
+            return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+        }
+    #endif
 
-                // Go to next arg
-                current = next;
-            }
+    static void FreeResponseFiles(SAH_Parser *parser)
+    {
+        while (parser->argFiles != NULL)
+        {
+            ArgFile *next = parser->argFiles->next;
+            #ifdef SAH_USE_MMAP
+                munmap((void *) parser->argFiles->data, parser->argFiles->size);
+            #else
+                free((void *) parser->argFiles->data);
+            #endif
+            free(parser->argFiles);
+            parser->argFiles = next;
+        }
+        while (parser->keptText != NULL)
+        {
+            ArgBlock *next = parser->keptText->next;
+            free(parser->keptText);
+            parser->keptText = next;
+        }
+        parser->fileTokenCount = 0;
+    }
+
+    void SAH_FreeArgs(SAH_Parser *parser)
+    {
+        FreeResponseFiles(parser);
+        // Release list values and copies of values
+        for (int i = 0; parser->argHandles != NULL && i < parser->argCount; i++)
+        {
+            free(parser->argHandles[i]->items);
+            free(parser->argHandles[i]->kept);
+        }
+        free(parser->argTokens);
+        parser->argTokens = NULL;
+        free(parser->fileTokens);
+        parser->fileTokens = NULL;
+        parser->fileTokenCapacity = 0;
+        for (int i = 0; i < 2; i++)
+        {
+            free(parser->unquoted[i]);
+            parser->unquoted[i] = NULL;
+            parser->unquotedSize[i] = 0;
         }
+        free(parser->streamBuffer);
+        parser->streamBuffer = NULL;
+        parser->streamSize = 0;
+        parser->streamArg = parser->stdinArg = NULL;
+        parser->tokenCount = parser->tokenCapacity = 0;
+
+        // Every arg, value and the index live in the arena, so only its blocks are released
+        while (parser->arena != NULL)
+        {
+            ArgBlock *next = parser->arena->next;
+            if (parser->arena != parser->userBlock) free(parser->arena);
+            parser->arena = next;
+        }
+        parser->userBlock = NULL;
+
+        parser->argIndex = NULL;
+        parser->argIndexSize = 0;
+        parser->argHandles = NULL;
+        parser->positionalArgs = NULL;
+        parser->argCapacity = parser->positionalCapacity = 0;
+        parser->boolBits = NULL;
+        parser->trie = NULL;
+        parser->trieArgs = NULL;
+        parser->commands = parser->command = NULL;
     }
 
-    static void PrintAndQuit(const char *text)
+    static void PrintAndQuit(SAH_Parser *parser, const char *text)
     {
         // If text is not empty, print it
         if (text[0] != '\0') printf("%s\n", text);
-        FreeArgs();
+        SAH_FreeArgs(parser);
         exit(EXIT_FAILURE);
     }
 
+    static void PrintUsage(SAH_Parser *parser);
+
+    static void ReportError(SAH_Parser *parser, int code, bool canReturn, const char *format, va_list args)
+    {
+        // No output: message goes to the caller's buffer, then back to TryParseArgs() (or the getter, in non-fatal mode)
+        if (parser->errorJump != NULL || (canReturn && parser->nonFatal))
+        {
+            if (parser->errorBuffer != NULL) vsnprintf(parser->errorBuffer, parser->errorSize, format, args);
+            parser->error = code;
+            if (parser->errorJump != NULL) longjmp(*parser->errorJump, code);
+            return;
+        }
+
+        vprintf(format, args);
+        printf("\n");
+        if (code <= SAH_ERROR_COMMAND) PrintUsage(parser);
+        PrintAndQuit(parser, "");
+    }
+
+    // Print error and exit (or return from TryParseArgs() with code)
+    static void ArgError(SAH_Parser *parser, int code, const char *format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        ReportError(parser, code, false, format, args);
+        va_end(args);
+    }
+
+    // Same, but in non-fatal mode the getter gets control back and returns an empty value
+    static void AccessError(SAH_Parser *parser, int code, const char *format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        ReportError(parser, code, true, format, args);
+        va_end(args);
+    }
+
+    static void* ArenaAlloc(SAH_Parser *parser, size_t size)
+    {
+        // Keep every allocation aligned
+        size = (size + SAH_ALIGN - 1) / SAH_ALIGN * SAH_ALIGN;
+
+        // If current block can't fit it, grab a new one from the heap
+        if (parser->arena == NULL || parser->arena->size - parser->arena->used < size)
+        {
+            size_t blockSize = (size > SAH_BLOCK_SIZE) ? size : SAH_BLOCK_SIZE;
+            ArgBlock *block = (ArgBlock *) malloc(SAH_BLOCK_HEADER + blockSize);
+            SAH_Count(parser, allocations, 1);
+            SAH_Count(parser, allocatedBytes, SAH_BLOCK_HEADER + blockSize);
+            if (block == NULL)
+                ArgError(parser, SAH_ERROR_MEMORY, "simplearghandler: Error: Memory allocation failed :(");
+
+            block->size = blockSize;
+            block->used = 0;
+            block->next = parser->arena;
+            parser->arena = block;
+        }
+
+        void *ptr = (unsigned char *) parser->arena + SAH_BLOCK_HEADER + parser->arena->used;
+        parser->arena->used += size;
+        // Blocks may be reused or caller supplied, so hand out zeroed memory like calloc
+        memset(ptr, 0, size);
+        return ptr;
+    }
+
+    // Use a caller supplied buffer for all allocations (call before adding any argument)
+    // If buffer is big enough, no heap allocation is made at all
+    void SAH_SetArgBuffer(SAH_Parser *parser, void *buffer, size_t size)
+    {
+        if (parser->arena != NULL)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: SetArgBuffer() must be called before adding arguments");
+
+        // Align start of buffer
+        size_t offset = (SAH_ALIGN - (size_t) buffer % SAH_ALIGN) % SAH_ALIGN;
+        if (buffer == NULL || size < offset + SAH_BLOCK_HEADER)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Argument buffer is too small");
+
+        parser->userBlock = (ArgBlock *) ((unsigned char *) buffer + offset);
+        parser->userBlock->size = (size - offset - SAH_BLOCK_HEADER) / SAH_ALIGN * SAH_ALIGN;
+        parser->userBlock->used = 0;
+        parser->userBlock->next = NULL;
+        parser->arena = parser->userBlock;
+    }
+
+    // Lazy mode (call before InitArgs()): parsing only records which token belongs to which arg,
+    // numbers and chars are converted and checked on first access, by a getter or HasArg()/GetArgCount() (so errors show up
+    // there, and they write to the parser). An invalid value is never reported as set
+    void SAH_SetLazyArgs(SAH_Parser *parser, bool lazy)
+    {
+        parser->lazy = lazy;
+    }
+
+    // Response files (call before InitArgs(), off by default): an @file argument is replaced with the file's contents.
+    // Only tokens where an argument can go are expanded, never the value of an option (-n @bob is the value "@bob")
+    // Leave off for untrusted command lines (e.g. with TryParseArgs()), since any readable file can be named
+    void SAH_SetResponseFiles(SAH_Parser *parser, bool enabled)
+    {
+        parser->responseFiles = enabled;
+    }
+
+    // Shell completion (call before InitArgs(), off by default): InitArgs() answers a command line ending with
+    // --complete [prefix] by printing the matching names and exiting. ParseArgs() never does, so reparsing can't exit
+    void SAH_SetCompletion(SAH_Parser *parser, bool enabled)
+    {
+        parser->completion = enabled;
+    }
+
     static int GetHyphenEnd(const char* hyphenatedText)
     {
         int textStart = 1;
@@ -95,257 +534,729 @@
         return textStart;
     }
 
-    static void PrintUsage(void)
+    static void PrintCommandUsage(SAH_Parser *parser);
+
+    // [-shortName --longName] ([-shortName --longName ...] for lists) or 'longName' ('longName'... for lists)
+    static void PrintArgUsage(Arg *arg)
     {
-        // Keeps track of last string printed, string to be printed
         char usageText[SAH_STRING_MAX + 1];
-        
-        printf("usage: %s ", appName);
-        // Go through all assigned/used arguments
-        for (int i = 0; i < usedCount; i++)
-        {
-            // Current argument
-            Arg *current = args[indexesUsed[i]];
-            while (current != NULL)
-            {
-                // Clear string
-                strcpy(usageText, "");
-                // For optional args use this format: [-shortName --longName]
-                if (current->optional)
-                    sprintf(usageText, "[-%s --%s]", current->shortName, current->longName);
-                // For positional args use this format: 'longName'
-                else
-                    sprintf(usageText, "'%s'", current->longName);
-                printf("%s ", usageText);
+        if (arg->optional)
+            snprintf(usageText, sizeof(usageText), "[-%s --%s%s%s%s]", arg->shortName, arg->longName,
+                     (arg->choiceText != NULL) ? " " : "", (arg->choiceText != NULL) ? arg->choiceText : "", arg->list ? " ..." : "");
+        else
+            snprintf(usageText, sizeof(usageText), "'%s'%s", arg->longName, arg->list ? "..." : "");
+        printf("%s ", usageText);
+    }
 
-                // Go to next arg
-                current = current->next;
-            }
-        }
+    // ( -sName, --lName newline  help), choices after the name
+    static void PrintOptionalHelp(Arg *arg)
+    {
+        printf("  -%s, --%s%s%s\n\t%s\n", arg->shortName, arg->longName, (arg->choiceText != NULL) ? " " : "", (arg->choiceText != NULL) ? arg->choiceText : "", arg->help);
+    }
+
+    // Args added before InitArgs() work with every command (once one is picked, the rest of argHandles are its own)
+    static int GlobalCount(SAH_Parser *parser)
+    {
+        return (parser->command != NULL) ? parser->globalCount : parser->argCount;
+    }
+
+    static void PrintUsage(SAH_Parser *parser)
+    {
+        // No command picked yet, show the commands instead
+        if (parser->commands != NULL && parser->command == NULL) PrintCommandUsage(parser);
+
+        printf("usage: %s ", parser->appName);
+        // Positional arguments first, then optional ones, each in the order they were added
+        for (int i = 0; i < parser->positionalCount; i++)
+            PrintArgUsage(parser->positionalArgs[i]);
+        for (int i = 0; i < parser->argCount; i++)
+            if (parser->argHandles[i]->optional) PrintArgUsage(parser->argHandles[i]);
         printf("\n");
 
-        PrintAndQuit("");
+        PrintAndQuit(parser, "");
     }
 
-    static void PrintHelp(void)
+    static void PrintCommandUsage(SAH_Parser *parser)
     {
-        printf("%s\n\n", appDesc);
+        printf("usage: %s ", parser->appName);
+        // Global options go before (or after) the command
+        for (int i = 0; i < GlobalCount(parser); i++)
+            if (parser->argHandles[i]->optional) PrintArgUsage(parser->argHandles[i]);
+        printf("{");
+        for (ArgCommand *command = parser->commands; command != NULL; command = command->next)
+            printf("%s%s", command->name, (command->next != NULL) ? "," : "");
+        printf("} ... [-h --help]\n");
+
+        PrintAndQuit(parser, "");
+    }
 
-        // First positional arguments, if any
-        if (positionalCount > 0) printf("Positional arguments:\n");
-        // Print all arguments
-        for (int i = 0; i < usedCount; i++)
-        {
-            // When finished printing pos args, print opt args
-            if (i == positionalCount) printf("Optional arguments:\n");
-            Arg *arg = args[indexesUsed[i]];
-            while (arg != NULL)
-            {
-                // Print pos args in this format ( name  help)
-                if (i < positionalCount)
-                    printf("  %s\t\t%s\n", arg->longName, arg->help);
-                // Print opt args in this format ( --sName, --lName newline  help)
-                else
-                    printf("  -%s, --%s\n\t%s\n", arg->shortName, arg->longName, arg->help);
+    static void PrintCommandHelp(SAH_Parser *parser)
+    {
+        if (parser->errorJump != NULL) ArgError(parser, SAH_ERROR_HELP, "%s: Help requested", parser->appName);
+        printf("%s\n\nCommands:\n", parser->appDesc);
+        // Print commands in this format ( name  help)
+        for (ArgCommand *command = parser->commands; command != NULL; command = command->next)
+            printf("  %s\t\t%s\n", command->name, command->help);
+
+        // Then the global options (--help is only added with the first parse, so it's printed here)
+        printf("Optional arguments:\n");
+        for (int i = 0; i < GlobalCount(parser); i++)
+            if (parser->argHandles[i]->optional) PrintOptionalHelp(parser->argHandles[i]);
+        printf("  -h, --help\n\tShow this help message\n");
+        printf("\nUse '%s <command> --help' for a command's arguments\n\n", parser->appName);
+
+        PrintCommandUsage(parser);
+    }
 
-                arg = arg->next;
-            }
+    static void PrintHelp(SAH_Parser *parser)
+    {
+        if (parser->errorJump != NULL) ArgError(parser, SAH_ERROR_HELP, "%s: Help requested", parser->appName);
+        printf("%s\n\n", parser->appDesc);
+
+        // First positional arguments, if any
+        if (parser->positionalCount > 0) printf("Positional arguments:\n");
+        // Print pos args in this format ( name  help), choices after the name
+        for (int i = 0; i < parser->positionalCount; i++)
+        {
+            Arg *arg = parser->positionalArgs[i];
+            printf("  %s%s%s\t\t%s\n", arg->longName, (arg->choiceText != NULL) ? " " : "", (arg->choiceText != NULL) ? arg->choiceText : "", arg->help);
         }
 
+        // Then opt args (there's always --help)
+        printf("Optional arguments:\n");
+        for (int i = 0; i < parser->argCount; i++)
+            if (parser->argHandles[i]->optional) PrintOptionalHelp(parser->argHandles[i]);
+
         printf("\n");
-        PrintUsage();
+        PrintUsage(parser);
     }
 
-    // For args that have a different starting letter for short and long name
-    static Arg* LinearSearchTable(const char* key)
+    // FNV-1a hash of the first 'length' characters of name
+    static unsigned int HashName(const char *name, size_t length)
     {
-        for (int i = 0; i < usedCount; i++)
+        unsigned int hash = 2166136261u;
+        for (size_t i = 0; i < length; i++)
+            hash = (hash ^ (unsigned char) name[i]) * 16777619u;
+        return hash;
+    }
+
+    static void AddToIndex(SAH_Parser *parser, Arg *arg, const char *name)
+    {
+        // Positional args have no short name
+        if (name[0] == '\0') return;
+
+        unsigned int hash = HashName(name, strlen(name)), mask = parser->argIndexSize - 1;
+        // Linear probing until an empty slot
+        for (unsigned int i = hash & mask; ; i = (i + 1) & mask)
         {
-            Arg *temp = args[indexesUsed[i]];
-            while (temp != NULL)
+            SAH_Count(parser, duplicateChecks, 1);
+            ArgIndexSlot *slot = &parser->argIndex[i];
+            if (slot->arg == NULL)
             {
-                // If current arg has matching name, arg found
-                if (!strcmp(key, temp->shortName) || !strcmp(key, temp->longName))
-                    return temp;
-
-                // Move to next arg
-                temp = temp->next;
+                slot->hash = hash;
+                slot->name = name;
+                slot->arg = arg;
+                return;
             }
+            if (slot->hash != hash || strcmp(slot->name, name)) continue;
+
+            // An arg's short and long name can be the same
+            if (slot->arg == arg) return;
+            // Any other clash (short or long, with short or long) would make one of the names unreachable
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Duplicate name (%s/%s) found: %s/%s", slot->arg->shortName, slot->arg->longName, arg->shortName, arg->longName);
         }
+    }
 
-        return NULL;
+    // Make room for one more arg: handles and positionals grow by doubling, the index doubles and is rebuilt before it's half full
+    // (old arrays stay in the arena, which at most doubles what they take)
+    static void GrowArgs(SAH_Parser *parser, bool optional)
+    {
+        if (parser->argCount == parser->argCapacity)
+        {
+            int capacity = (parser->argCapacity > 0) ? parser->argCapacity * 2 : 16;
+            Arg **handles = (Arg **) ArenaAlloc(parser, capacity * sizeof(Arg *));
+            if (parser->argCount > 0) memcpy(handles, parser->argHandles, parser->argCount * sizeof(Arg *));
+            parser->argHandles = handles;
+            parser->argCapacity = capacity;
+        }
+
+        if (!optional && parser->positionalCount == parser->positionalCapacity)
+        {
+            int capacity = (parser->positionalCapacity > 0) ? parser->positionalCapacity * 2 : 4;
+            Arg **positionals = (Arg **) ArenaAlloc(parser, capacity * sizeof(Arg *));
+            if (parser->positionalCount > 0) memcpy(positionals, parser->positionalArgs, parser->positionalCount * sizeof(Arg *));
+            parser->positionalArgs = positionals;
+            parser->positionalCapacity = capacity;
+        }
+
+        // Room for every short and long name at half load
+        if ((unsigned int) (parser->argCount + 1) * 2 * SAH_INDEX_LOAD > parser->argIndexSize)
+        {
+            unsigned int size = (parser->argIndexSize > 0) ? parser->argIndexSize * 2 : 64;
+            SAH_Count(parser, indexGrows, 1);
+            parser->argIndex = (ArgIndexSlot *) ArenaAlloc(parser, size * sizeof(ArgIndexSlot));
+            parser->argIndexSize = size;
+            // Names already in are known to be unique, so this can't fail
+            for (int i = 0; i < parser->argCount; i++)
+            {
+                AddToIndex(parser, parser->argHandles[i], parser->argHandles[i]->shortName);
+                AddToIndex(parser, parser->argHandles[i], parser->argHandles[i]->longName);
+            }
+        }
     }
 
-    static Arg* SearchTable(const char *key)
+    // Look up the first 'length' characters of key (key doesn't need to end there, e.g. "name=value")
+    static Arg* SearchIndex(SAH_Parser *parser, const char *key, size_t length)
     {
         // If first character is not alphanumeric, return NULL
-        if (!isalnum(key[0])) return NULL;
+        if (length == 0 || !isalnum(key[0])) return NULL;
 
-        // Get arg based on first letter
-        Arg *temp = args[SAH_GetTableIndex(key[0])];
-        while (temp != NULL)
+        // A lookup is one probe sequence and one string compare
+        SAH_Count(parser, lookups, 1);
+        unsigned int hash = HashName(key, length), mask = parser->argIndexSize - 1;
+        for (unsigned int i = hash & mask; parser->argIndex[i].arg != NULL; i = (i + 1) & mask)
         {
-            // If current arg has matching name, arg found
-            if (!strcmp(key, temp->shortName) || !strcmp(key, temp->longName))
-                return temp;
+            SAH_Count(parser, probes, 1);
+            const char *name = parser->argIndex[i].name;
+            if (parser->argIndex[i].hash == hash && !strncmp(key, name, length) && name[length] == '\0')
+                return parser->argIndex[i].arg;
+        }
+        return NULL;
+    }
+
+    static Arg* SearchTable(SAH_Parser *parser, const char *key)
+    {
+        // Nothing added yet
+        if (parser->argIndex == NULL) return NULL;
+        return SearchIndex(parser, key, strlen(key));
+    }
+
+    static int CompareLongNames(const void *a, const void *b)
+    {
+        return strcmp((*(Arg * const *) a)->longName, (*(Arg * const *) b)->longName);
+    }
 
-            // Move to next arg
-            temp = temp->next;
+    static void BuildTrie(SAH_Parser *parser)
+    {
+        // Long names of optional args, sorted so every prefix covers a range of them
+        int count = 0;
+        for (int i = 0; i < parser->argCount; i++) count += parser->argHandles[i]->optional;
+        parser->trieArgs = (Arg **) ArenaAlloc(parser, count * sizeof(Arg *));
+        count = 0;
+        for (int i = 0; i < parser->argCount; i++)
+            if (parser->argHandles[i]->optional) parser->trieArgs[count++] = parser->argHandles[i];
+        qsort(parser->trieArgs, count, sizeof(Arg *), CompareLongNames);
+
+        // One node per distinct prefix: each name adds the characters it doesn't share with the one before it
+        size_t nodeTotal = 1;
+        for (int i = 0; i < count; i++)
+        {
+            const char *name = parser->trieArgs[i]->longName, *previous = (i > 0) ? parser->trieArgs[i - 1]->longName : "";
+            size_t shared = 0;
+            while (name[shared] != '\0' && name[shared] == previous[shared]) shared++;
+            nodeTotal += strlen(name + shared);
         }
+        ArgTrieNode *nodes = (ArgTrieNode *) ArenaAlloc(parser, nodeTotal * sizeof(ArgTrieNode));
+        memset(&nodes[0], 0, sizeof(ArgTrieNode));
+        nodes[0].end = count;
+        int nodeCount = 1;
 
-        // If arg not found, try doing a linear search
-        return LinearSearchTable(key);
+        // Breadth first, so a node's children are added one after another
+        for (int n = 0; n < nodeCount; n++)
+        {
+            ArgTrieNode *node = &nodes[n];
+            node->firstChild = nodeCount;
+            int i = node->start;
+            // A name equal to the prefix sorts first and has nothing after it
+            if (i < node->end && parser->trieArgs[i]->longName[node->depth] == '\0') i++;
+
+            // One child per next character
+            while (i < node->end)
+            {
+                char ch = parser->trieArgs[i]->longName[node->depth];
+                int groupEnd = i + 1;
+                while (groupEnd < node->end && parser->trieArgs[groupEnd]->longName[node->depth] == ch) groupEnd++;
+
+                ArgTrieNode *child = &nodes[nodeCount++];
+                child->ch = (unsigned char) ch;
+                child->depth = node->depth + 1;
+                child->childCount = 0;
+                child->start = i;
+                child->end = groupEnd;
+                node->childCount++;
+                i = groupEnd;
+            }
+        }
+        parser->trie = nodes;
     }
 
-    static void InsertNewIndex(int insertIndex, int index)
+    // Node of the first 'length' characters of prefix (NULL if no long name starts with them)
+    static ArgTrieNode* SearchTrie(SAH_Parser *parser, const char *prefix, size_t length)
     {
-        if (usedCount > 0)
+        if (parser->trie == NULL) BuildTrie(parser);
+
+        ArgTrieNode *node = &parser->trie[0];
+        for (size_t d = 0; d < length; d++)
         {
-            // Go from the last index to insertion index
-            for (int i = usedCount; i >= insertIndex; i--)
-                // Shift elements backward and when at insertion index add new index
-                indexesUsed[i] = (i == insertIndex) ? index : indexesUsed[i - 1];
+            // Binary search the children for the next character
+            unsigned char ch = (unsigned char) prefix[d];
+            int low = node->firstChild, high = node->firstChild + node->childCount;
+            while (low < high)
+            {
+                int middle = low + (high - low) / 2;
+                if (parser->trie[middle].ch < ch) low = middle + 1;
+                else high = middle;
+            }
+            if (low == node->firstChild + node->childCount || parser->trie[low].ch != ch) return NULL;
+            node = &parser->trie[low];
         }
-        else
-            indexesUsed[usedCount] = index;
-        // Item added
-        usedCount++;
+        return node;
     }
 
-    static void AddNewIndex(int index, Arg *arg)
+    // Arg whose long name is the only one starting with the first 'length' characters of prefix, e.g. max for max-lines
+    static Arg* SearchPrefix(SAH_Parser *parser, const char *prefix, size_t length)
     {
-        // Go through all assigned/used arguments
-        for (int i = 0; i < usedCount; i++)
-            // If index is already in list, exit function
-            if (indexesUsed[i] == index) return;
+        ArgTrieNode *node = SearchTrie(parser, prefix, length);
+        if (node == NULL) return NULL;
+        if (node->end - node->start == 1) return parser->trieArgs[node->start];
+
+        // List a few of the names it could be
+        char names[SAH_STRING_MAX + 1] = "";
+        size_t used = 0;
+        for (int i = node->start; i < node->end && i < node->start + 4 && used < sizeof(names); i++)
+            used += snprintf(names + used, sizeof(names) - used, "%s--%s", (i > node->start) ? ", " : "", parser->trieArgs[i]->longName);
+        ArgError(parser, SAH_ERROR_UNKNOWN_ARG, "%s: Error: Ambiguous argument: --%.*s could be %s%s", parser->appName,
+                 (int) length, prefix, names, (node->end - node->start > 4) ? ", ..." : "");
+        return NULL;
+    }
 
-        // Else, add new index to list
+    // Parse an unsigned decimal or hex (0x) number, the whole text must be a number
+    static int ParseUnsigned(const char *text, uint64_t *result)
+    {
+        uint64_t value = 0;
+        int base = 10;
 
-        // Add optional argument to end of list
-        if (arg->optional)
-            indexesUsed[usedCount++] = index;
-        // Insert positional argument at the positionalCount index
-        else
+        // Allow an explicit plus sign
+        if (text[0] == '+') text++;
+        // Hex prefix
+        if (text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+        {
+            base = 16;
+            text += 2;
+        }
+        // Needs at least one digit
+        if (text[0] == '\0') return SAH_NUMBER_INVALID;
+        // Largest value that can still take another digit
+        uint64_t limit = UINT64_MAX / base;
+        unsigned int lastDigit = (unsigned int) (UINT64_MAX % base);
+
+        for (; *text != '\0'; text++)
         {
-            InsertNewIndex(positionalCount, index);
-            // Add positional arg name to list
-            strcpy(positionalArgNames[positionalCount++], arg->longName);
+            unsigned int digit;
+            // Not using isdigit()/isxdigit() so nothing depends on the locale
+            if (*text >= '0' && *text <= '9') digit = *text - '0';
+            else if (base == 16 && *text >= 'a' && *text <= 'f') digit = *text - 'a' + 10;
+            else if (base == 16 && *text >= 'A' && *text <= 'F') digit = *text - 'A' + 10;
+            else return SAH_NUMBER_INVALID;
+
+            // Would value * base + digit overflow?
+            if (value > limit || (value == limit && digit > lastDigit)) return SAH_NUMBER_RANGE;
+            value = value * base + digit;
         }
+
+        *result = value;
+        return SAH_NUMBER_OK;
     }
 
-    static void AddToTable(Arg *arg, const char *key)
+    // Parse a signed decimal or hex (0x) number e.g. -42, 0x2A
+    static int ParseSigned(const char *text, int64_t *result)
     {
-        // Get index based on first character
-        int tableIndex = SAH_GetTableIndex(key[0]);
+        bool negative = text[0] == '-';
+        uint64_t magnitude;
 
-        // If current index is empty
-        if (args[tableIndex] == NULL)
-            // Set arg to it
-            args[tableIndex] = arg;
-        else
+        // Don't let ParseUnsigned() see a second sign
+        if (text[0] == '-' || text[0] == '+') text++;
+        if (text[0] == '-' || text[0] == '+') return SAH_NUMBER_INVALID;
+
+        int status = ParseUnsigned(text, &magnitude);
+        if (status != SAH_NUMBER_OK) return status;
+
+        // INT64_MIN has one more value than INT64_MAX
+        if (magnitude > (negative ? (uint64_t) INT64_MAX + 1 : (uint64_t) INT64_MAX)) return SAH_NUMBER_RANGE;
+        *result = negative ? (int64_t) (0 - magnitude) : (int64_t) magnitude;
+        return SAH_NUMBER_OK;
+    }
+
+    // Parse a decimal number with optional sign, fraction and exponent e.g. -1.5e-3 (always uses '.')
+    static int ParseDouble(const char *text, double *result)
+    {
+        // Powers of ten that are exact as doubles
+        static const double powersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                              1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+        const char *start = text;
+        uint64_t mantissa = 0;
+        int exponent = 0, digits = 0, significant = 0;
+        // True when digits didn't fit in mantissa
+        bool truncated = false;
+
+        bool negative = text[0] == '-';
+        if (text[0] == '-' || text[0] == '+') text++;
+
+        // Integer part then fraction, keeping at most 19 significant digits in mantissa
+        for (bool fraction = false; ; text++)
         {
-            Arg *temp = args[tableIndex];
-            // Look for null arg (using a do-while loop because I want the check-duplicate code to run at least once)
-            do 
+            if (*text == '.' && !fraction)
             {
-                // If current arg has the same name as new arg (duplicate check)
-                if (!strcmp(arg->shortName, temp->shortName) || !strcmp(arg->longName, temp->longName))
-                {
-                    printf("simplearghandler: Error: Duplicate name (%s/%s) found: %s/%s\n", temp->shortName, temp->longName, arg->shortName, arg->longName);
-                    PrintAndQuit("");
-                }
+                fraction = true;
+                continue;
+            }
+            if (*text < '0' || *text > '9') break;
+
+            digits++;
+            // Skip leading zeros
+            if (mantissa == 0 && *text == '0')
+            {
+                if (fraction) exponent--;
+                continue;
+            }
+            if (significant < 19)
+            {
+                mantissa = mantissa * 10 + (*text - '0');
+                significant++;
+                if (fraction) exponent--;
+            }
+            else
+            {
+                truncated = truncated || *text != '0';
+                if (!fraction) exponent++;
+            }
+        }
+        if (digits == 0) return SAH_NUMBER_INVALID;
+
+        // Exponent
+        if (*text == 'e' || *text == 'E')
+        {
+            text++;
+            bool negativeExponent = text[0] == '-';
+            if (text[0] == '-' || text[0] == '+') text++;
+            if (*text < '0' || *text > '9') return SAH_NUMBER_INVALID;
+
+            int value = 0;
+            for (; *text >= '0' && *text <= '9'; text++)
+                // Anything past this is overflow or zero anyway
+                if (value < 100000) value = value * 10 + (*text - '0');
+            exponent += negativeExponent ? -value : value;
+        }
+        if (*text != '\0') return SAH_NUMBER_INVALID;
 
-                // Go to next arg if next arg is not null
-                if (temp->next != NULL) temp = temp->next;
-            } while (temp->next != NULL);
+        // Fast path: mantissa and power of ten are both exact, so one multiply/divide is correctly rounded
+        if (!truncated && mantissa <= ((uint64_t) 1 << 53) && exponent >= -22 && exponent <= 22)
+        {
+            double value = (double) mantissa;
+            value = (exponent >= 0) ? value * powersOfTen[exponent] : value / powersOfTen[-exponent];
+            *result = negative ? -value : value;
+            return SAH_NUMBER_OK;
+        }
+
+        // Slow path: strtod (text is known to be valid), with '.' swapped for the locale's decimal point if it isn't '.'
+        char decimalPoint = localeconv()->decimal_point[0];
+        const char *point = strchr(start, '.');
+        char buffer[128], *copy = (char *) start;
+        if (point != NULL && decimalPoint != '.')
+        {
+            // Any length is a number, long ones are copied to the heap
+            size_t length = strlen(start);
+            copy = (length < sizeof(buffer)) ? buffer : (char *) malloc(length + 1);
+            if (copy == NULL) return SAH_NUMBER_RANGE;
+            memcpy(copy, start, length + 1);
+            copy[point - start] = decimalPoint;
+        }
+
+        errno = 0;
+        double value = strtod(copy, NULL);
+        bool overflow = errno == ERANGE && (value == HUGE_VAL || value == -HUGE_VAL);
+        if (copy != start && copy != buffer) free(copy);
+        if (overflow) return SAH_NUMBER_RANGE;
+        *result = value;
+        return SAH_NUMBER_OK;
+    }
+
+    // Value just converted, as a list item
+    static ArgItem CurrentItem(Arg *arg)
+    {
+        ArgItem item = arg->number;
+        if (arg->argType == ARG_CHAR || arg->argType == ARG_STRING) item.text = (const char *) arg->value;
+        return item;
+    }
 
-            // Set null arg
-            temp->next = arg;
+    // Add arg's current value to its list
+    static void AppendItem(SAH_Parser *parser, Arg *arg)
+    {
+        // Double capacity when full, so appending is amortized O(1)
+        if (arg->itemCount == arg->itemCapacity)
+        {
+            int capacity = (arg->itemCapacity > 0) ? arg->itemCapacity * 2 : 8;
+            ArgItem *items = (ArgItem *) realloc(arg->items, capacity * sizeof(ArgItem));
+            SAH_Count(parser, allocations, 1);
+            SAH_Count(parser, allocatedBytes, capacity * sizeof(ArgItem));
+            if (items == NULL)
+                ArgError(parser, SAH_ERROR_MEMORY, "simplearghandler: Error: Memory allocation failed :(");
+            arg->items = items;
+            arg->itemCapacity = capacity;
         }
 
-        // Add index to indexesUsed
-        AddNewIndex(tableIndex, arg);
-    } 
+        arg->items[arg->itemCount++] = CurrentItem(arg);
+        arg->value = arg->items;
+    }
+
+    // Index of value in an ARG_CHOICE's choices (-1 if it isn't one), one hash and usually one strcmp()
+    static int FindChoice(Arg *arg, const char *value)
+    {
+        // Same hash as HashName(), without a strlen() first
+        unsigned int hash = 2166136261u;
+        for (const char *c = value; *c != '\0'; c++) hash = (hash ^ (unsigned char) *c) * 16777619u;
+
+        for (unsigned int slot = hash & arg->choiceMask; arg->choiceSlots[slot] != 0; slot = (slot + 1) & arg->choiceMask)
+        {
+            int choice = arg->choiceSlots[slot] - 1;
+            if (!strcmp(arg->choices[choice], value)) return choice;
+        }
+        return -1;
+    }
 
-    static void SetValue(Arg *arg, const char *value)
+    // Convert and validate value based on arg type (false if it isn't valid, in non-fatal mode)
+    static bool ConvertValue(SAH_Parser *parser, Arg *arg, const char *value)
     {
-        // Set value of arg based on arg type
         switch (arg->argType)
         {
-            case ARG_INT: case ARG_FLOAT:
-                // If first letter is not a digit, then quit
-                if (!isdigit(value[0]))
+            case ARG_INT: case ARG_INT64: case ARG_UINT64: case ARG_FLOAT: case ARG_DOUBLE:
+            {
+                int result;
+                if (arg->argType == ARG_UINT64)
+                    result = ParseUnsigned(value, &arg->number.u);
+                else if (arg->argType == ARG_INT || arg->argType == ARG_INT64)
+                {
+                    result = ParseSigned(value, &arg->number.i);
+                    // INT has to fit in an int
+                    if (result == SAH_NUMBER_OK && arg->argType == ARG_INT && (arg->number.i < INT_MIN || arg->number.i > INT_MAX))
+                        result = SAH_NUMBER_RANGE;
+                }
+                else
+                {
+                    result = ParseDouble(value, &arg->number.d);
+                    // FLOAT has to fit in a float
+                    if (result == SAH_NUMBER_OK && arg->argType == ARG_FLOAT && (arg->number.d > FLT_MAX || arg->number.d < -FLT_MAX))
+                        result = SAH_NUMBER_RANGE;
+                }
+
+                if (result != SAH_NUMBER_OK)
                 {
-                    printf("%s: Error: -%s/--%s: invalid number value: %s\n", appName, arg->shortName, arg->longName, value);
-                    PrintUsage();
+                    AccessError(parser, (result == SAH_NUMBER_RANGE) ? SAH_ERROR_RANGE : SAH_ERROR_INVALID_VALUE, "%s: Error: -%s/--%s: %s: %s", parser->appName, arg->shortName, arg->longName, (result == SAH_NUMBER_RANGE) ? "number out of range" : "invalid number value", value);
+                    return false;
                 }
-                
-                // Else, allocate memory for a float and set it's value
-                SAH_Alloc(float, floating, sizeof(float), atof(value));
-                // Point arg's value field to new memory address
-                arg->value = floating;
+
+                // Stored inline, no allocation
+                arg->value = &arg->number;
                 break;
+            }
 
-            case ARG_CHAR: case ARG_STRING:
-                // If char contains more than one letter, quit
-                if (arg->argType == ARG_CHAR && strlen(value) > 1)
+            case ARG_CHOICE:
+                arg->number.i = FindChoice(arg, value);
+                if (arg->number.i < 0)
                 {
-                    printf("%s: Error: -%s/--%s: invalid char value: %s\n", appName, arg->shortName, arg->longName, value);
-                    PrintUsage();
+                    AccessError(parser, SAH_ERROR_INVALID_VALUE, "%s: Error: -%s/--%s: invalid choice: %s (choose from %s)", parser->appName, arg->shortName, arg->longName, value, arg->choiceText);
+                    return false;
                 }
+                arg->value = &arg->number;
+                break;
 
-                // Make sure string is a reasonable size
-                else if(arg->argType == ARG_STRING && strlen(value) > SAH_STRING_MAX)
+            case ARG_CHAR: case ARG_STRING:
+                // If char contains more than one letter, quit
+                if (arg->argType == ARG_CHAR && value[0] != '\0' && value[1] != '\0')
                 {
-                    printf("%s: Error: -%s/--%s: String too long: %s\n", appName, arg->shortName, arg->longName, value);
-                    PrintUsage();
+                    AccessError(parser, SAH_ERROR_INVALID_VALUE, "%s: Error: -%s/--%s: invalid char value: %s", parser->appName, arg->shortName, arg->longName, value);
+                    return false;
                 }
 
-                // Else, allocate memory for a string/char and set it's value
-                SAH_Alloc(char, string, sizeof(char) * (strlen(value) + 1), value[0]);
-                // If a string, copy value to address
-                if (arg->argType == ARG_STRING) strcpy(string, value);
-                // Point arg's value field to new memory address
-                arg->value = string;
+                // argv and response files outlive the values, so point straight into them (no length limit, see KeepText())
+                arg->value = (void *) value;
                 break;
 
             // Unknown arg type
             default:
-                PrintAndQuit("simplearghandler: Error: Unknown argument type\nArgument types: ARG_INT, ARG_BOOL, ARG_CHAR, ARG_FLOAT, ARG_STRING");
+                ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Unknown argument type\nArgument types: ARG_INT, ARG_BOOL, ARG_CHAR, ARG_FLOAT, ARG_STRING, ARG_INT64, ARG_UINT64, ARG_DOUBLE, ARG_CHOICE");
                 break;
         }
+        return true;
+    }
+
+    // Unquoted response file tokens are reused (see Token()), so a value that's kept as text gets a copy:
+    // lists get one per item (freed on the next parse), other args reuse their own buffer
+    static const char* KeepText(SAH_Parser *parser, Arg *arg, const char *value)
+    {
+        size_t size = strlen(value) + 1;
+        char *copy;
+        if (arg->list)
+        {
+            ArgBlock *block = parser->keptText;
+            if (block == NULL || block->size - block->used < size)
+            {
+                size_t blockSize = (size > SAH_BLOCK_SIZE) ? size : SAH_BLOCK_SIZE;
+                block = (ArgBlock *) malloc(SAH_BLOCK_HEADER + blockSize);
+                SAH_Count(parser, allocations, 1);
+                SAH_Count(parser, allocatedBytes, SAH_BLOCK_HEADER + blockSize);
+                if (block == NULL)
+                    ArgError(parser, SAH_ERROR_MEMORY, "simplearghandler: Error: Memory allocation failed :(");
+                block->size = blockSize;
+                block->used = 0;
+                block->next = parser->keptText;
+                parser->keptText = block;
+            }
+            copy = (char *) block + SAH_BLOCK_HEADER + block->used;
+            block->used += size;
+        }
+        else
+        {
+            if (size > arg->keptSize)
+            {
+                char *kept = (char *) realloc(arg->kept, size);
+                SAH_Count(parser, allocations, 1);
+                SAH_Count(parser, allocatedBytes, size);
+                if (kept == NULL)
+                    ArgError(parser, SAH_ERROR_MEMORY, "simplearghandler: Error: Memory allocation failed :(");
+                arg->kept = kept;
+                arg->keptSize = size;
+            }
+            copy = arg->kept;
+        }
+        memcpy(copy, value, size);
+        return copy;
+    }
+
+    // Does value point into one of the unquoted token buffers?
+    static bool IsUnquoted(SAH_Parser *parser, const char *value)
+    {
+        for (int slot = 0; slot < 2; slot++)
+            if (parser->unquoted[slot] != NULL && value >= parser->unquoted[slot] && value < parser->unquoted[slot] + parser->unquotedSize[slot])
+                return true;
+        return false;
+    }
+
+    static void SetValue(SAH_Parser *parser, Arg *arg, const char *value)
+    {
+        // Actions get the value as soon as it's converted, nothing is kept
+        if (arg->action != NULL)
+        {
+            if (ConvertValue(parser, arg, value)) arg->action(arg->handle, CurrentItem(arg), arg->actionData);
+            arg->value = NULL;
+            return;
+        }
+
+        // Strings, chars and lazy tokens point at their value
+        if ((arg->argType == ARG_STRING || arg->argType == ARG_CHAR || (parser->lazy && !arg->list)) && IsUnquoted(parser, value))
+            value = KeepText(parser, arg, value);
+
+        // Lazy mode only records the token, CheckArg() converts it on first access (strings have nothing to convert)
+        if (parser->lazy && !arg->list && arg->argType != ARG_STRING)
+        {
+            arg->raw = value;
+            arg->value = (arg->argType == ARG_CHAR) ? (void *) value : &arg->number;
+            return;
+        }
+
+        // Lists keep every (valid) value
+        if (ConvertValue(parser, arg, value) && arg->list) AppendItem(parser, arg);
+    }
+
+    // For number args, "-5" or "-.5" following the arg (or in place of a positional) is its value (unless it's a registered arg)
+    static bool IsNegativeNumber(SAH_Parser *parser, Arg *arg, const char *text)
+    {
+        if (arg->argType != ARG_INT && arg->argType != ARG_INT64 && arg->argType != ARG_FLOAT && arg->argType != ARG_DOUBLE)
+            return false;
+        if (!((text[1] >= '0' && text[1] <= '9') || text[1] == '.')) return false;
+        return SearchIndex(parser, &text[1], strcspn(&text[1], "=")) == NULL;
+    }
+
+    // Bools are only a bit, so setting and reading them never touches the heap
+    static void SetFlag(SAH_Parser *parser, Arg *arg)
+    {
+        parser->boolBits[arg->bit / 64] |= (uint64_t) 1 << (arg->bit % 64);
+    }
+
+    static bool IsSet(SAH_Parser *parser, Arg *arg)
+    {
+        if (arg->count) return arg->number.i > 0;
+        if (arg->argType != ARG_BOOL) return arg->value != NULL;
+        return parser->boolBits != NULL && ((parser->boolBits[arg->bit / 64] >> (arg->bit % 64)) & 1);
+    }
+
+    // Args that take no value: bools are a bit and counts go up by one (actions get true or the count instead of the bit)
+    static void SetSwitch(SAH_Parser *parser, Arg *arg)
+    {
+        if (arg->count) arg->number.i++;
+        else if (arg->action == NULL) SetFlag(parser, arg);
+        if (arg->action == NULL) return;
+
+        ArgItem item = arg->number;
+        if (!arg->count) item.i = 1;
+        arg->action(arg->handle, item, arg->actionData);
     }
 
-    static void SetupArg(Arg *arg, const char *shortName, const char *longName, const char *help, int argType, bool optional)
+    static void SetupArg(SAH_Parser *parser, Arg *arg, const char *shortName, const char *longName, const char *help, int argType, bool optional)
     {
         // If allocation successful
         if (arg != NULL)
         {
+            bool list = (argType & ARG_LIST) != 0, count = (argType & ARG_COUNT) != 0;
+            argType &= ~(ARG_LIST | ARG_COUNT);
+
+            // Type is checked here once, so getters only compare it
+            if (argType < ARG_INT || argType > ARG_CHOICE)
+                ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Unknown argument type\nArgument types: ARG_INT, ARG_BOOL, ARG_CHAR, ARG_FLOAT, ARG_STRING, ARG_INT64, ARG_UINT64, ARG_DOUBLE, ARG_CHOICE");
+            if (list && argType == ARG_BOOL)
+                ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: ARG_BOOL can't be a list");
+            if (count && (list || argType != ARG_INT || !optional))
+                ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: ARG_COUNT is an optional ARG_INT and can't be a list");
+            // Nothing can come after a positional list
+            if (!optional && parser->variadicArg != NULL)
+            {
+                ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Positional list (%s) has to be the last positional argument", parser->variadicArg->longName);
+            }
+
             // Set shortName if given
             strcpy(arg->shortName, (shortName[0] != '\0') ? shortName : "");
             strcpy(arg->longName, longName);
             strcpy(arg->help, help);
             arg->argType = argType;
+            arg->list = list;
+            arg->count = count;
             arg->optional = optional;
-            arg->value = NULL;
-            arg->next = NULL;
-
-            // Add to table using name as the key
-            AddToTable(arg, optional ? arg->shortName : arg->longName);
+            // Counts start at 0
+            arg->value = count ? &arg->number : NULL;
+
+            // Index both names (checking they're not taken), then give it the next handle
+            GrowArgs(parser, optional);
+            AddToIndex(parser, arg, arg->shortName);
+            AddToIndex(parser, arg, arg->longName);
+            arg->handle = parser->argCount++;
+            parser->argHandles[arg->handle] = arg;
+            if (!optional) parser->positionalArgs[parser->positionalCount++] = arg;
+            if (argType == ARG_BOOL) arg->bit = parser->boolCount++;
+            if (!optional && list) parser->variadicArg = arg;
         }
         // Allocation not successful
         else
-            PrintAndQuit("simplearghandler: Error: Memory allocation failed :(");
+            ArgError(parser, SAH_ERROR_MEMORY, "simplearghandler: Error: Memory allocation failed :(");
     }
 
-    void AddOptionalArg(const char *shortName, const char *longName, const char *help, int argType)
+    ArgHandle SAH_AddOptionalArg(SAH_Parser *parser, const char *shortName, const char *longName, const char *help, int argType)
     {
-        if (initialised)
-            PrintAndQuit("simplearghandler: Error: Can't add more arguments, InitArgs() has already been called");
+        if (parser->registered)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Can't add more arguments, InitArgs() has already been called");
 
         // If names are empty
         if (shortName[0] == '\0' || longName[0] == '\0')
-            PrintAndQuit("Name can't be empty!");
+            ArgError(parser, SAH_ERROR_USAGE, "Name can't be empty!");
 
         // If text exceeds max, print error
         if (strlen(shortName) > SAH_SHORT_NAME_MAX || strlen(longName) > SAH_LONG_NAME_MAX || strlen(help) > SAH_STRING_MAX)
@@ -355,30 +1266,31 @@
             else if (strlen(help) > SAH_STRING_MAX) strcpy(startText, "Help text");
             int maxNum = (!strcmp(startText, "Long name")) ? SAH_LONG_NAME_MAX : (!strcmp(startText, "Help text")) ? SAH_STRING_MAX : SAH_SHORT_NAME_MAX;
 
-            printf("simplearghandler: Error: %s is too long! Max is %i characters\n", startText, maxNum);
-            PrintAndQuit("");
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: %s is too long! Max is %i characters", startText, maxNum);
         }
 
         // If name doesn't start with a letter or number or contains a space
         if (!isalnum(shortName[0]) || !isalnum(longName[0]) || strchr(shortName, ' ') != NULL || strchr(longName, ' ') != NULL)
         {
-            printf("simplearghandler: Error: Name (%s) should only contain letters and numbers, and no spaces\n", (!isalnum(shortName[0]) ? shortName : longName));
-            PrintAndQuit("");
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Name (%s) should only contain letters and numbers, and no spaces", (!isalnum(shortName[0]) ? shortName : longName));
         }
 
+        SAH_TimeStart(start);
         // Allocate memory for a new arg
-        Arg *arg = (Arg *) calloc(1, sizeof(Arg));
-        SetupArg(arg, shortName, longName, help, argType, true);
+        Arg *arg = (Arg *) ArenaAlloc(parser, sizeof(Arg));
+        SetupArg(parser, arg, shortName, longName, help, argType, true);
+        SAH_TimeEnd(parser, registerTime, start);
+        return arg->handle;
     }
 
-    void AddPositionalArg(const char *name, const char *help, int argType)
+    ArgHandle SAH_AddPositionalArg(SAH_Parser *parser, const char *name, const char *help, int argType)
     {
-        if (initialised)
-            PrintAndQuit("simplearghandler: Error: Can't add more arguments, InitArgs() has already been called");
+        if (parser->registered)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Can't add more arguments, InitArgs() has already been called");
 
         // If name is empty
         if (name[0] == '\0')
-            PrintAndQuit("Name can't be empty!");
+            ArgError(parser, SAH_ERROR_USAGE, "Name can't be empty!");
 
         // If text exceeds max, print error
         if (strlen(name) > SAH_LONG_NAME_MAX || strlen(help) > SAH_STRING_MAX)
@@ -387,214 +1299,1849 @@
             if (strlen(help) > SAH_STRING_MAX) strcpy(startText, "Help text");
             int maxNum = (!strcmp(startText, "Name")) ? SAH_LONG_NAME_MAX : SAH_STRING_MAX;
 
-            printf("simplearghandler: Error: %s is too long! Max is %i characters\n", startText, maxNum);
-            PrintAndQuit("");
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: %s is too long! Max is %i characters", startText, maxNum);
         }
 
         // If name doesn't start with a letter or number
         if (!isalnum(name[0]))
         {
-            printf("simplearghandler: Error: Name (%s) should only contain letters and numbers\n", name);
-            PrintAndQuit("");
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Name (%s) should only contain letters and numbers", name);
         }
 
+        SAH_TimeStart(start);
         // Allocate memory for a new arg
-        Arg *arg = (Arg *) calloc(1, sizeof(Arg));
-        SetupArg(arg, "", name, help, argType, false);
+        Arg *arg = (Arg *) ArenaAlloc(parser, sizeof(Arg));
+        SetupArg(parser, arg, "", name, help, argType, false);
+        SAH_TimeEnd(parser, registerTime, start);
+        return arg->handle;
     }
 
-    void InitArgs(int argc, const char* argv[], const char* appDescription)
+    // Have action called with each value of an arg as it's parsed, instead of storing it (call before InitArgs())
+    // Values come converted (text: STRING/CHAR, i: INT/INT64/CHOICE and ARG_COUNT's count so far, u: UINT64, d: FLOAT/DOUBLE, i = 1: BOOL),
+    // so HasArg()/Get*Arg() don't see them (except counts)
+    void SAH_SetArgAction(SAH_Parser *parser, ArgHandle handle, SAH_ArgAction action, void *data)
     {
-        if (initialised)
-            PrintAndQuit("simplearghandler: Error: Can't initialise more than once");
+        if (parser->registered)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: SetArgAction() must be called before InitArgs()");
+        if (handle < 0 || handle >= parser->argCount)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Invalid handle: %i", handle);
 
-        // Get app name and descrption
-        strcpy(appName, argv[0]);
-        strcpy(appDesc, appDescription);
+        parser->argHandles[handle]->action = action;
+        parser->argHandles[handle]->actionData = data;
+    }
 
-        // Help arg
-        AddOptionalArg("h", "help", "Show this help message", ARG_BOOL);
+    // Give an ARG_CHOICE its allowed values (call before InitArgs()), the value given is read as its index with GetChoiceArg()
+    // The choices are copied and hashed once here, so parsing a value is a hash lookup instead of a strcmp() per choice
+    void SAH_SetArgChoices(SAH_Parser *parser, ArgHandle handle, const char *choices[], int count)
+    {
+        if (parser->registered)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: SetArgChoices() must be called before InitArgs()");
+        if (handle < 0 || handle >= parser->argCount)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Invalid handle: %i", handle);
+
+        Arg *arg = parser->argHandles[handle];
+        if (arg->argType != ARG_CHOICE)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: %s is not of type CHOICE!", arg->longName);
+        if (count <= 0)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: %s needs at least one choice", arg->longName);
+
+        // Copies of the choices, then all of them joined with '|'
+        size_t textSize = 0;
+        for (int i = 0; i < count; i++)
+        {
+            if (choices[i][0] == '\0')
+                ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: %s: Choice can't be empty!", arg->longName);
+            textSize += strlen(choices[i]) + 1;
+        }
+        char *copies = (char *) ArenaAlloc(parser, textSize * 2);
+        char *text = copies + textSize;
+        arg->choices = (const char **) ArenaAlloc(parser, count * sizeof(const char *));
+
+        // At least twice as many slots as choices, so probes stay short
+        unsigned int slots = 4;
+        while (slots < (unsigned int) count * 2) slots *= 2;
+        arg->choiceSlots = (int *) ArenaAlloc(parser, slots * sizeof(int));
+        arg->choiceMask = slots - 1;
+        arg->choiceCount = count;
+        arg->choiceText = text;
+
+        for (int i = 0; i < count; i++)
+        {
+            size_t length = strlen(choices[i]);
+            memcpy(copies, choices[i], length + 1);
+            arg->choices[i] = copies;
+            copies += length + 1;
+            text += sprintf(text, (i > 0) ? "|%s" : "%s", choices[i]);
+
+            if (FindChoice(arg, choices[i]) >= 0)
+                ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: %s: Choice %s is given twice", arg->longName, choices[i]);
+            unsigned int slot = HashName(choices[i], length) & arg->choiceMask;
+            while (arg->choiceSlots[slot] != 0) slot = (slot + 1) & arg->choiceMask;
+            arg->choiceSlots[slot] = i + 1;
+        }
+    }
 
-        int positionalsAdded = 0;
-        // Go through all arguments excluding first one (app name)
-        for (int i = 1; i < argc; i++)
+    static void AddToken(SAH_Parser *parser, const char *token)
+    {
+        // Grow by doubling, memory is proportional to the number of tokens
+        if (parser->tokenCount == parser->tokenCapacity)
         {
-            // Optional argument
-            if (argv[i][0] == '-' && argv[i][GetHyphenEnd(argv[i])] != '\0')
-            {
-                int hypenEnd = GetHyphenEnd(argv[i]);
-                // If --help or -h is used, print help
-                if (!strcmp(&argv[i][hypenEnd], "help") || !strcmp(&argv[i][hypenEnd], "h"))
-                    PrintHelp();
+            parser->tokenCapacity = (parser->tokenCapacity > 0) ? parser->tokenCapacity * 2 : 64;
+            const char **tokens = (const char **) realloc(parser->argTokens, parser->tokenCapacity * sizeof(const char *));
+            SAH_Count(parser, allocations, 1);
+            SAH_Count(parser, allocatedBytes, parser->tokenCapacity * sizeof(const char *));
+            if (tokens == NULL)
+                ArgError(parser, SAH_ERROR_MEMORY, "simplearghandler: Error: Memory allocation failed :(");
+            parser->argTokens = tokens;
+        }
+        parser->argTokens[parser->tokenCount++] = token;
+    }
+
+    static void AddFileToken(SAH_Parser *parser, const char *token)
+    {
+        // Grow by doubling, memory is proportional to the number of tokens (not the size of the files)
+        if (parser->fileTokenCount == parser->fileTokenCapacity)
+        {
+            parser->fileTokenCapacity = (parser->fileTokenCapacity > 0) ? parser->fileTokenCapacity * 2 : 64;
+            const char **tokens = (const char **) realloc(parser->fileTokens, parser->fileTokenCapacity * sizeof(const char *));
+            SAH_Count(parser, allocations, 1);
+            SAH_Count(parser, allocatedBytes, parser->fileTokenCapacity * sizeof(const char *));
+            if (tokens == NULL)
+                ArgError(parser, SAH_ERROR_MEMORY, "simplearghandler: Error: Memory allocation failed :(");
+            parser->fileTokens = tokens;
+        }
+        parser->fileTokens[parser->fileTokenCount++] = token;
+    }
+
+    // Load file so that data[size] is a readable zero byte, returns NULL if it can't be read
+    static ArgFile* LoadResponseFile(SAH_Parser *parser, const char *path, size_t *size)
+    {
+        // Not from the arena, so reparsing with response files doesn't grow it
+        ArgFile *file = (ArgFile *) malloc(sizeof(ArgFile));
+        SAH_Count(parser, allocations, 1);
+        SAH_Count(parser, allocatedBytes, sizeof(ArgFile));
+        if (file == NULL)
+            ArgError(parser, SAH_ERROR_MEMORY, "simplearghandler: Error: Memory allocation failed :(");
+
+        #ifdef SAH_USE_MMAP
+            int fd = open(path, O_RDONLY);
+            struct stat info;
+            if (fd < 0 || fstat(fd, &info) != 0)
+            {
+                if (fd >= 0) close(fd);
+                free(file);
+                return NULL;
+            }
+            *size = (size_t) info.st_size;
+
+            // Reserve zeroed pages with room for one extra byte, then map the file over the start of them
+            // Read only: tokens are never written, so the pages stay clean and shared with the page cache
+            size_t page = (size_t) sysconf(_SC_PAGESIZE);
+            file->size = (*size / page + 1) * page;
+            file->data = (const char *) mmap(NULL, file->size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            SAH_Count(parser, allocations, 1);
+            SAH_Count(parser, allocatedBytes, file->size);
+            if (file->data == MAP_FAILED)
+            {
+                close(fd);
+                free(file);
+                return NULL;
+            }
+            if (*size > 0 && mmap((void *) file->data, *size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+            {
+                munmap((void *) file->data, file->size);
+                close(fd);
+                free(file);
+                return NULL;
+            }
+            close(fd);
+        #else
+            // No mmap, read the whole file into one buffer
+            FILE *stream = fopen(path, "rb");
+            if (stream == NULL)
+            {
+                free(file);
+                return NULL;
+            }
+            fseek(stream, 0, SEEK_END);
+            *size = (size_t) ftell(stream);
+            fseek(stream, 0, SEEK_SET);
+
+            file->size = *size + 1;
+            char *data = (char *) calloc(file->size, 1);
+            SAH_Count(parser, allocations, 1);
+            SAH_Count(parser, allocatedBytes, file->size);
+            if (data == NULL || fread(data, 1, *size, stream) != *size)
+            {
+                free(data);
+                free(file);
+                fclose(stream);
+                return NULL;
+            }
+            fclose(stream);
+            file->data = data;
+        #endif
+
+        file->next = parser->argFiles;
+        parser->argFiles = file;
+        return file;
+    }
+
+    // Bytes a whitespace delimited token takes up in the file (up to unquoted whitespace or the zero byte after the file),
+    // quote is left as the quote that's still open ('\0' if none)
+    static size_t QuotedTokenLength(const char *token, char *quote)
+    {
+        size_t length = 0;
+        *quote = '\0';
+        for (; token[length] != '\0' && (*quote != '\0' || !isspace((unsigned char) token[length])); length++)
+        {
+            char ch = token[length];
+            // Escapes work everywhere except in single quotes
+            if (ch == '\\' && *quote != '\'' && token[length + 1] != '\0')
+                length++;
+            else if ((ch == '"' || ch == '\'') && *quote == '\0')
+                *quote = ch;
+            else if (ch == *quote)
+                *quote = '\0';
+        }
+        return length;
+    }
+
+    // Split response file into tokens without copying or writing them, only where each one starts is kept
+    // If the file contains a NUL byte, tokens are NUL delimited (e.g. find -print0) and used in place
+    // Else tokens are whitespace delimited with '' and "" quoting and \ escapes, unquoted by Token() when parsed
+    static void TokenizeResponseFile(SAH_Parser *parser, const char *path)
+    {
+        size_t size = 0;
+        ArgFile *file = LoadResponseFile(parser, path, &size);
+        if (file == NULL)
+        {
+            ArgError(parser, SAH_ERROR_FILE, "%s: Error: Can't read response file: %s", parser->appName, path);
+        }
+        const char *data = file->data;
+        file->first = parser->fileTokenCount;
+        file->quoted = memchr(data, '\0', size) == NULL;
+
+        if (!file->quoted)
+        {
+            // Last token ends on the zero byte after the file
+            for (size_t start = 0; start < size; start += strlen(&data[start]) + 1)
+                AddFileToken(parser, &data[start]);
+        }
+
+        for (size_t read = 0; file->quoted && read < size; read++)
+        {
+            // Skip whitespace
+            if (isspace((unsigned char) data[read])) continue;
+
+            char quote;
+            AddFileToken(parser, &data[read]);
+            read += QuotedTokenLength(&data[read], &quote);
+            if (quote != '\0')
+            {
+                ArgError(parser, SAH_ERROR_FILE, "%s: Error: Missing closing quote (%c) in response file: %s", parser->appName, quote, path);
+            }
+        }
+        file->count = parser->fileTokenCount - file->first;
+    }
+
+    // Token i of the command line: argv[i], or the i-th expanded token if there were response files
+    // An unquoted token stays until token i + 2 is unquoted (see KeepText())
+    static const char* Token(SAH_Parser *parser, const char* argv[], int i)
+    {
+        if (parser->fileTokenCount == 0) return argv[i];
+        const char *token = parser->fileTokens[i];
+        // Tokens from argv and NUL delimited files end where they are
+        ArgFile *file = parser->argFiles;
+        while (file != NULL && (i < file->first || i >= file->first + file->count)) file = file->next;
+        if (file == NULL || !file->quoted) return token;
+
+        int slot = i % 2;
+        if (parser->unquotedToken[slot] == i) return parser->unquoted[slot];
+        // Unquoted token is never longer than the token in the file (TokenizeResponseFile() already checked the quotes)
+        char quote;
+        size_t length = QuotedTokenLength(token, &quote);
+        if (length + 1 > parser->unquotedSize[slot])
+        {
+            size_t size = (length + 1 > 2 * parser->unquotedSize[slot]) ? length + 1 : 2 * parser->unquotedSize[slot];
+            char *buffer = (char *) realloc(parser->unquoted[slot], size);
+            SAH_Count(parser, allocations, 1);
+            SAH_Count(parser, allocatedBytes, size);
+            if (buffer == NULL)
+                ArgError(parser, SAH_ERROR_MEMORY, "simplearghandler: Error: Memory allocation failed :(");
+            parser->unquoted[slot] = buffer;
+            parser->unquotedSize[slot] = size;
+        }
+
+        // Same rules as QuotedTokenLength()
+        char *write = parser->unquoted[slot];
+        for (size_t read = 0; read < length; read++)
+        {
+            char ch = token[read];
+            if (ch == '\\' && quote != '\'' && read + 1 < length)
+                *write++ = token[++read];
+            else if ((ch == '"' || ch == '\'') && quote == '\0')
+                quote = ch;
+            else if (ch == quote)
+                quote = '\0';
+            else
+                *write++ = ch;
+        }
+        *write = '\0';
+        parser->unquotedToken[slot] = i;
+        return parser->unquoted[slot];
+    }
+
+    // Does token (an arg in the parse loop) take the token after it as its value? (same rules as the parse loop)
+    static bool TakesNextToken(SAH_Parser *parser, const char *token)
+    {
+        int hyphenEnd = GetHyphenEnd(token);
+        if (token[0] != '-' || token[hyphenEnd] == '\0' || strchr(token, '=') != NULL) return false;
+
+        const char *name = &token[hyphenEnd];
+        Arg *arg = SearchIndex(parser, name, strlen(name));
+        if (arg == NULL && hyphenEnd == 2) arg = SearchPrefix(parser, name, strlen(name));
+        if (arg != NULL) return arg->argType != ARG_BOOL && !arg->count;
+        if (hyphenEnd != 1) return false;
+
+        // Bundle: the first arg that takes a value gets the rest of the token, or the next token if it's last
+        for (int c = 0; name[c] != '\0'; c++)
+        {
+            arg = SearchIndex(parser, &name[c], 1);
+            if (arg == NULL) return false;
+            if (arg->argType != ARG_BOOL && !arg->count) return name[c + 1] == '\0';
+        }
+        return false;
+    }
+
+    // If any argument is @file, the file's tokens take its place (argc becomes the expanded count, see Token())
+    static void ExpandResponseFiles(SAH_Parser *parser, int *argc, const char ***argv)
+    {
+        if (!parser->responseFiles) return;
+        int i = 1;
+        for (; i < *argc && (*argv)[i][0] != '@'; i++);
+        if (i == *argc) return;
+
+        parser->unquotedToken[0] = parser->unquotedToken[1] = -1;
+        for (i = 0; i < *argc; i++)
+        {
+            const char *token = (*argv)[i];
+            // Tokens from a response file aren't expanded again, and neither are values of options
+            if (i > 0 && token[0] == '@' && token[1] != '\0' && !TakesNextToken(parser, Token(parser, *argv, parser->fileTokenCount - 1)))
+                TokenizeResponseFile(parser, &token[1]);
+            else
+                AddFileToken(parser, token);
+        }
+
+        // Parse loop reads the tokens through Token()
+        *argc = parser->fileTokenCount;
+    }
+
+    // Add a git style subcommand: 'app name ...' calls setup (which adds the command's args) and parses the rest of argv
+    // with them, so only the selected command's args are ever registered. Args added before InitArgs() apply to every command
+    void SAH_AddCommand(SAH_Parser *parser, const char *name, const char *help, SAH_CommandSetup setup)
+    {
+        if (parser->registered)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Can't add more commands, InitArgs() has already been called");
+
+        if (strlen(name) > SAH_LONG_NAME_MAX || strlen(help) > SAH_STRING_MAX)
+        {
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: %s is too long! Max is %i characters", (strlen(help) > SAH_STRING_MAX) ? "Help text" : "Command name",
+                   (strlen(help) > SAH_STRING_MAX) ? SAH_STRING_MAX : SAH_LONG_NAME_MAX);
+        }
+
+        // If name doesn't start with a letter or number or contains a space
+        if (!isalnum(name[0]) || strchr(name, ' ') != NULL)
+        {
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Command name (%s) should only contain letters and numbers, and no spaces", name);
+        }
+
+        // Commands are kept in order (and checked for duplicates) in a list
+        ArgCommand **last = &parser->commands;
+        for (; *last != NULL; last = &(*last)->next)
+        {
+            if (!strcmp((*last)->name, name))
+            {
+                ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Duplicate command: %s", name);
+            }
+        }
+
+        ArgCommand *command = (ArgCommand *) ArenaAlloc(parser, sizeof(ArgCommand));
+        strcpy(command->name, name);
+        strcpy(command->help, help);
+        command->setup = setup;
+        *last = command;
+    }
+
+    // Name of the selected command (NULL if there are no commands)
+    const char* SAH_GetCommand(SAH_Parser *parser)
+    {
+        if (!parser->initialised)
+        {
+            AccessError(parser, SAH_ERROR_NOT_PARSED, "simplearghandler: Error: Call InitArgs() before accessing arguments!");
+            return NULL;
+        }
+        return (parser->command != NULL) ? parser->command->name : NULL;
+    }
+
+    // The first token that isn't a global option picks the command: the first parse registers its args, argv then goes
+    // on without the command
+    // app [words] --complete <prefix>: print every command, --name or -name starting with prefix (one per line) and exit
+    static void CompleteArgs(SAH_Parser *parser, const char *prefix)
+    {
+        size_t length = strlen(prefix);
+        // Commands, until one is selected
+        if (parser->commands != NULL && parser->command == NULL)
+        {
+            for (ArgCommand *command = parser->commands; command != NULL; command = command->next)
+                if (!strncmp(command->name, prefix, length)) printf("%s\n", command->name);
+        }
+        // Long names, straight from the trie
+        else if (length == 0 || !strncmp(prefix, "--", (length < 2) ? length : 2))
+        {
+            ArgTrieNode *node = SearchTrie(parser, prefix + ((length < 2) ? length : 2), (length < 2) ? 0 : length - 2);
+            for (int i = (node != NULL) ? node->start : 0; node != NULL && i < node->end; i++)
+                printf("--%s\n", parser->trieArgs[i]->longName);
+        }
+        // Short names
+        else if (prefix[0] == '-')
+        {
+            for (int i = 0; i < parser->argCount; i++)
+            {
+                Arg *arg = parser->argHandles[i];
+                if (arg->optional && !strncmp(arg->shortName, prefix + 1, length - 1)) printf("-%s\n", arg->shortName);
+            }
+        }
+
+        SAH_FreeArgs(parser);
+        exit(EXIT_SUCCESS);
+    }
+
+    static void SelectCommand(SAH_Parser *parser, int *argc, const char ***argv, bool complete)
+    {
+        // Options before the command are global args (with their values), the first other token is the command
+        int at = 1;
+        for (; at < *argc && (*argv)[at][0] == '-' && (*argv)[at][GetHyphenEnd((*argv)[at])] != '\0'; at++)
+        {
+            const char *option = (*argv)[at];
+            if (complete && !strcmp(option, "--complete")) CompleteArgs(parser, (at + 1 < *argc) ? (*argv)[at + 1] : "");
+            // Top level help lists the commands
+            if (!strcmp(option, "-h") || !strcmp(option, "--help")) PrintCommandHelp(parser);
+            if (TakesNextToken(parser, option) && at + 1 < *argc) at++;
+        }
+
+        const char *name = (at < *argc) ? (*argv)[at] : "";
+        ArgCommand *command = parser->commands;
+        for (; command != NULL && strcmp(command->name, name); command = command->next);
+
+        if (command == NULL)
+        {
+            if (name[0] == '\0') ArgError(parser, SAH_ERROR_COMMAND, "%s: Error: Expected a command", parser->appName);
+            ArgError(parser, SAH_ERROR_COMMAND, "%s: Error: Unknown command: %s", parser->appName, name);
+        }
+
+        // Later parses reuse the registered args, so they have to be for the same command
+        if (parser->command == NULL)
+        {
+            parser->command = command;
+            parser->globalCount = parser->argCount;
+            // Command's help is the description of its own help
+            snprintf(parser->appDesc, sizeof(parser->appDesc), "%s", command->help);
+            if (command->setup != NULL) command->setup(parser);
+            // Long names were looked up before the command's args (and help) were added
+            parser->trie = NULL;
+        }
+        else if (parser->command != command)
+        {
+            ArgError(parser, SAH_ERROR_USAGE, "%s: Error: Command %s was already selected, use a new parser for %s", parser->appName, parser->command->name, name);
+        }
+
+        // Usage and errors show "app command"
+        snprintf(parser->appName, sizeof(parser->appName), "%s %s", (*argv)[0], command->name);
+        if (at == 1)
+        {
+            (*argc)--;
+            (*argv)++;
+            return;
+        }
+
+        // Global options came first: argv without the command goes in argTokens
+        for (int i = 0; i < *argc; i++)
+            if (i != at) AddToken(parser, (*argv)[i]);
+        *argc = parser->tokenCount;
+        *argv = parser->argTokens;
+    }
+
+    // Set arg's value to the token after it (token *i + 1), quit if there isn't one
+    static void SetNextValue(SAH_Parser *parser, Arg *arg, int argc, const char* argv[], int *i)
+    {
+        const char *value = (*i + 1 < argc) ? Token(parser, argv, *i + 1) : NULL;
+        // If there is no value following arg declaration
+        if (value == NULL || (value[0] == '-' && !IsNegativeNumber(parser, arg, value)))
+        {
+            ArgError(parser, SAH_ERROR_MISSING_VALUE, "%s: Error: -%s/--%s: expected one argument", parser->appName, arg->shortName, arg->longName);
+        }
+        // Else set arg's value
+        (*i)++;
+        SetValue(parser, arg, value);
+    }
+
+    // POSIX style bundle of one character short names, in one pass: flags until an arg that takes a value,
+    // which gets the rest of the token (-nl5, -nl=5) or the next token (-nl 5)
+    // Returns false if the first character isn't a short name (so the whole token is unrecognised)
+    static bool ParseBundle(SAH_Parser *parser, int argc, const char* argv[], int *i)
+    {
+        const char *token = Token(parser, argv, *i), *bundle = &token[1];
+        for (int c = 0; bundle[c] != '\0'; c++)
+        {
+            Arg *arg = SearchIndex(parser, &bundle[c], 1);
+            if (arg == NULL && c == 0) return false;
+            if (arg == NULL)
+            {
+                ArgError(parser, SAH_ERROR_UNKNOWN_ARG, "%s: Error: Unrecognised argument: -%c (in %s)", parser->appName, bundle[c], token);
+            }
+            if (!strcmp(arg->longName, "help")) PrintHelp(parser);
+
+            if (arg->argType == ARG_BOOL || arg->count)
+            {
+                SetSwitch(parser, arg);
+                continue;
+            }
+
+            const char *rest = &bundle[c + 1];
+            if (rest[0] == '=') rest++;
+            if (rest[0] != '\0') SetValue(parser, arg, rest);
+            else SetNextValue(parser, arg, argc, argv, i);
+            return true;
+        }
+        return true;
+    }
+
+    // Clear the values of every arg, keeping registered args (and memory) for the next SAH_ParseArgs()
+    void SAH_ResetArgs(SAH_Parser *parser)
+    {
+        // Tokens can be left by a first parse that failed before registration ended
+        FreeResponseFiles(parser);
+        parser->tokenCount = 0;
+        if (!parser->registered) return;
+
+        for (int i = 0; i < parser->argCount; i++)
+        {
+            parser->argHandles[i]->value = parser->argHandles[i]->count ? &parser->argHandles[i]->number : NULL;
+            parser->argHandles[i]->number.i = 0;
+            parser->argHandles[i]->raw = NULL;
+            // Lists keep their capacity
+            parser->argHandles[i]->itemCount = 0;
+        }
+        memset(parser->boolBits, 0, (parser->boolCount + 63) / 64 * sizeof(uint64_t));
+
+        // stdin keeps its buffer
+        parser->streamItem = 0;
+        parser->streamUsed = parser->streamStart = 0;
+        parser->streaming = parser->streamEnd = parser->streamDone = false;
+    }
+
+    #ifdef SAH_STATS
+        SAH_ArgStats SAH_GetArgStats(SAH_Parser *parser)
+        {
+            return parser->stats;
+        }
+
+        // One line of key=value pairs, so it can be grepped or diffed
+        void SAH_PrintArgStats(SAH_Parser *parser, FILE *stream)
+        {
+            SAH_ArgStats *stats = &parser->stats;
+            fprintf(stream, "simplearghandler: args=%i parses=%ld tokens=%ld lookups=%ld probes=%ld duplicate_checks=%ld index_grows=%ld "
+                    "allocations=%ld allocated_bytes=%ld register_ns=%llu response_ns=%llu parse_ns=%llu\n",
+                    parser->argCount, stats->parses, stats->tokens, stats->lookups, stats->probes, stats->duplicateChecks, stats->indexGrows,
+                    stats->allocations, stats->allocatedBytes, (unsigned long long) stats->registerTime,
+                    (unsigned long long) stats->responseTime, (unsigned long long) stats->parseTime);
+        }
+    #endif
+
+    static void EndRegistration(SAH_Parser *parser)
+    {
+        for (int i = 0; i < parser->argCount; i++)
+            if (parser->argHandles[i]->argType == ARG_CHOICE && parser->argHandles[i]->choices == NULL)
+                ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: %s is an ARG_CHOICE, give it its values with SetArgChoices()", parser->argHandles[i]->longName);
+
+        // Help arg
+        SAH_AddOptionalArg(parser, "h", "help", "Show this help message", ARG_BOOL);
+        // Registration is over, so the number of bools is known
+        parser->boolBits = (uint64_t *) ArenaAlloc(parser, (parser->boolCount + 63) / 64 * sizeof(uint64_t));
+        parser->registered = true;
+    }
+
+    // complete: answer --complete (only from InitArgs(), when it's turned on)
+    static void ParseCommandLine(SAH_Parser *parser, int argc, const char* argv[], bool complete)
+    {
+        // Never from TryInitArgs(), which mustn't exit
+        complete = complete && parser->errorJump == NULL;
+        snprintf(parser->appName, sizeof(parser->appName), "%s", argv[0]);
+        // Later parses start from a clean slate (before the command is selected, which may fill argTokens)
+        if (parser->registered) SAH_ResetArgs(parser);
+        if (parser->commands != NULL) SelectCommand(parser, &argc, &argv, complete);
+
+        // First parse ends registration
+        if (!parser->registered) EndRegistration(parser);
+
+        // Shell completion: the line typed so far ends with --complete <prefix> (unless the app has its own --complete)
+        if (complete && SearchIndex(parser, "complete", 8) == NULL)
+        {
+            if (argc > 2 && !strcmp(argv[argc - 2], "--complete")) CompleteArgs(parser, argv[argc - 1]);
+            if (argc > 1 && !strcmp(argv[argc - 1], "--complete")) CompleteArgs(parser, "");
+        }
+
+        // Replace @file arguments with the file's contents
+        SAH_TimeStart(responseStart);
+        ExpandResponseFiles(parser, &argc, &argv);
+        SAH_TimeEnd(parser, responseTime, responseStart);
+
+        SAH_TimeStart(parseStart);
+        SAH_Count(parser, parses, 1);
+        SAH_Count(parser, tokens, argc - 1);
+        int positionalsAdded = 0;
+        // Go through all arguments excluding first one (app name)
+        for (int i = 1; i < argc; i++)
+        {
+            const char *token = Token(parser, argv, i);
+            // Next positional to fill, a negative number can be its value (app -5) when it's a number arg
+            Arg *positional = (positionalsAdded < parser->positionalCount) ? parser->positionalArgs[positionalsAdded] : NULL;
+
+            // Optional argument
+            if (token[0] == '-' && token[GetHyphenEnd(token)] != '\0' && (positional == NULL || !IsNegativeNumber(parser, positional, token)))
+            {
+                int hypenEnd = GetHyphenEnd(token);
+                const char *name = &token[hypenEnd];
+                // Split --name=value / -n=value in place: name is looked up by length, value points past '='
+                const char *equals = strchr(name, '=');
+                size_t nameLength = (equals != NULL) ? (size_t) (equals - name) : strlen(name);
+
+                // Search table using text after hyphen
+                Arg *arg = SearchIndex(parser, name, nameLength);
+                // Long names can be shortened as long as only one starts with what's given
+                if (arg == NULL && hypenEnd == 2 && nameLength > 0) arg = SearchPrefix(parser, name, nameLength);
+                // If --help or -h is used, print help
+                if (arg != NULL && !strcmp(arg->longName, "help"))
+                    PrintHelp(parser);
 
-                // Search table using text after hyphen
-                Arg *arg = SearchTable(&argv[i][hypenEnd]);
                 // If arg found
                 if (arg != NULL)
                 {
-                    // If argument is of type bool
-                    if (arg->argType == ARG_BOOL)
+                    // If argument is of type bool (or a count)
+                    if (arg->argType == ARG_BOOL || arg->count)
                     {
-                        // Allocate memory for a bool and set it's value
-                        SAH_Alloc(bool, boolean, sizeof(bool), true);
-                        // Point arg's value to boolean
-                        arg->value = boolean;
+                        // Bools are set by their presence alone
+                        if (equals != NULL)
+                        {
+                            ArgError(parser, SAH_ERROR_INVALID_VALUE, "%s: Error: -%s/--%s: doesn't take a value", parser->appName, arg->shortName, arg->longName);
+                        }
+
+                        SetSwitch(parser, arg);
                     }
 
+                    // Value given after '='
+                    else if (equals != NULL)
+                        SetValue(parser, arg, equals + 1);
+
                     // Else of type: int, float, char, string
                     else
-                    {
-                        // If there is no value following arg declaration
-                        if (i + 1 >= argc || argv[i + 1][0] == '-')
-                        {
-                            printf("%s: Error: -%s/--%s: expected one argument\n", appName, arg->shortName, arg->longName);
-                            PrintUsage();
-                        }
-                        // Else set arg's value
-                        SetValue(arg, argv[++i]);
-                    }
+                        SetNextValue(parser, arg, argc, argv, &i);
                 }
 
+                // Single hyphen and not a name, try it as bundled short names (-nle, -l5)
+                else if (hypenEnd == 1 && ParseBundle(parser, argc, argv, &i))
+                    continue;
+
                 // Argument not found
                 else
                 {
-                    printf("%s: Error: Unrecognised argument: %s\n", appName, argv[i]);
-                    PrintUsage();
+                    ArgError(parser, SAH_ERROR_UNKNOWN_ARG, "%s: Error: Unrecognised argument: %s", parser->appName, token);
                 }
             }
 
             // Positional argument
             else
             {
+                // Positional list takes everything left
+                if (parser->variadicArg != NULL && positionalsAdded == parser->positionalCount - 1)
+                    SetValue(parser, parser->variadicArg, token);
+
                 // If there are still positional arguments left
-                if (positionalsAdded < positionalCount)
-                {
-                    // Search table for positional arg based on index
-                    Arg *arg = SearchTable(positionalArgNames[positionalsAdded++]);
-                    // If arg found
-                    if (arg != NULL) SetValue(arg, argv[i]);
-                }
+                else if (positionalsAdded < parser->positionalCount)
+                    SetValue(parser, parser->positionalArgs[positionalsAdded++], token);
 
                 // If no positional arguments are left, or there were none
                 else
                 {
-                    printf("%s: Error: Unrecognised argument: %s\n", appName, argv[i]);
-                    PrintUsage();
+                    ArgError(parser, SAH_ERROR_UNKNOWN_ARG, "%s: Error: Unrecognised argument: %s", parser->appName, token);
                 }
             }
         }
 
+        // Positional list can be empty
+        int requiredCount = parser->positionalCount - (parser->variadicArg != NULL);
+
         // If positional arguments are left
-        if (positionalsAdded < positionalCount)
+        if (positionalsAdded < requiredCount)
         {
-            printf("%s: Error: The following arguments are required: ", appName);
             // List all required arguments
-            for (int i = positionalsAdded; i < positionalCount; i++)
-                printf("'%s' ", positionalArgNames[i]);
-            printf("\n");
-            PrintUsage();
+            char names[SAH_STRING_MAX * 4 + 1] = "";
+            size_t used = 0;
+            for (int i = positionalsAdded; i < requiredCount && used < sizeof(names); i++)
+                used += snprintf(&names[used], sizeof(names) - used, "'%s' ", parser->positionalArgs[i]->longName);
+            ArgError(parser, SAH_ERROR_REQUIRED, "%s: Error: The following arguments are required: %s", parser->appName, names);
         }
 
-        initialised = true;
+        parser->initialised = true;
+        SAH_TimeEnd(parser, parseTime, parseStart);
+
+        #ifdef SAH_STATS
+            if (getenv("SAH_STATS") != NULL) SAH_PrintArgStats(parser, stderr);
+        #endif
     }
 
-    // Returns true if argument has been set (don't use for bools)
-    bool HasArg(const char *key)
+    // Parse argv against the registered args, can be called again for every new command line
+    // (after the first call, nothing is allocated unless lists grow or @file is used)
+    // Values live in the parser's args, so each parse replaces the last one: a parser is one schema plus one set of
+    // results, not a schema to share between threads (see SAH_Parser)
+    void SAH_ParseArgs(SAH_Parser *parser, int argc, const char* argv[])
     {
-        if (!initialised)
-            PrintAndQuit("simplearghandler: Error: Call InitArgs() before accessing arguments!");
-        return SearchTable(key)->value != NULL;
+        ParseCommandLine(parser, argc, argv, false);
     }
 
-    int GetIntArg(const char *key)
+    void SAH_InitArgs(SAH_Parser *parser, int argc, const char* argv[], const char* appDescription)
     {
-        Arg *arg = SearchTable(key);
-        if (!HasArg(key))
-        {
-            printf("simplearghandler: Error: %s not found\n", key);
-            PrintAndQuit("");
-        }
+        if (parser->initialised)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Can't initialise more than once");
 
-        else if (arg->argType != ARG_INT)
-        {
-            printf("simplearghandler: Error: %s is not of type INT!\n", key);
-            PrintAndQuit("");
-        }
+        // Get app descrption
+        snprintf(parser->appDesc, sizeof(parser->appDesc), "%s", appDescription);
+        ParseCommandLine(parser, argc, argv, parser->completion);
+    }
 
-        return (int) *((float *) arg->value);
+    // Non-fatal mode: error messages are written to buffer instead of printed, and getters return 0/NULL instead of exiting
+    // (check GetArgError()). Errors when adding args are mistakes in the app, those still print and exit
+    void SAH_SetErrorBuffer(SAH_Parser *parser, char *buffer, size_t size)
+    {
+        parser->errorBuffer = (size > 0) ? buffer : NULL;
+        parser->errorSize = size;
+        parser->nonFatal = true;
+        if (parser->errorBuffer != NULL) parser->errorBuffer[0] = '\0';
     }
 
-    float GetFloatArg(const char *key)
+    // Code of the last error (SAH_OK if none since the last TryParseArgs())
+    int SAH_GetArgError(SAH_Parser *parser)
     {
-        Arg *arg = SearchTable(key);
-        if (!HasArg(key))
-        {
-            printf("simplearghandler: Error: %s not found\n", key);
-            PrintAndQuit("");
-        }
+        return parser->error;
+    }
+
+    static int TryParse(SAH_Parser *parser, int argc, const char* argv[], const char* appDescription)
+    {
+        jmp_buf errorJump;
+        parser->error = SAH_OK;
+        if (parser->errorBuffer != NULL) parser->errorBuffer[0] = '\0';
 
-        else if (arg->argType != ARG_FLOAT)
+        // Errors jump back here instead of exiting
+        if (setjmp(errorJump) == 0)
         {
-            printf("simplearghandler: Error: %s is not of type FLOAT!\n", key);
-            PrintAndQuit("");
+            parser->errorJump = &errorJump;
+            if (appDescription != NULL) SAH_InitArgs(parser, argc, argv, appDescription);
+            else SAH_ParseArgs(parser, argc, argv);
         }
+        // Don't keep half a parse: after any error (app mistakes and memory included) no values are left
+        else
+            SAH_ResetArgs(parser);
 
-        return *((float *) arg->value);
+        parser->errorJump = NULL;
+        return parser->error;
     }
 
-    // Returns true if arg value is set else false
-    bool GetBoolArg(const char *key)
+    // Same as InitArgs()/ParseArgs(), but nothing is printed and the app doesn't exit:
+    // returns SAH_OK or an error code (message in the SetErrorBuffer() buffer), so untrusted command lines can be parsed in process
+    int SAH_TryInitArgs(SAH_Parser *parser, int argc, const char* argv[], const char* appDescription)
     {
-        Arg *arg = SearchTable(key);
-        if (arg == NULL)
+        return TryParse(parser, argc, argv, appDescription);
+    }
+
+    int SAH_TryParseArgs(SAH_Parser *parser, int argc, const char* argv[])
+    {
+        return TryParse(parser, argc, argv, NULL);
+    }
+
+    // Lazy mode: convert once, the result stays in arg (false if the value isn't valid, in non-fatal mode)
+    static bool ConvertRaw(SAH_Parser *parser, Arg *arg)
+    {
+        if (arg->raw == NULL) return true;
+
+        const char *raw = arg->raw;
+        arg->raw = NULL;
+        if (ConvertValue(parser, arg, raw)) return true;
+        arg->value = NULL;
+        return false;
+    }
+
+    // In non-fatal mode, access errors return NULL (or an empty item) and getters return 0, false, '\0' or NULL
+    static bool CheckParsed(SAH_Parser *parser)
+    {
+        if (!parser->initialised)
+            AccessError(parser, SAH_ERROR_NOT_PARSED, "simplearghandler: Error: Call InitArgs() before accessing arguments!");
+        return parser->initialised;
+    }
+
+    static Arg* HandleToArg(SAH_Parser *parser, ArgHandle handle)
+    {
+        if (!CheckParsed(parser)) return NULL;
+        if (handle < 0 || handle >= parser->argCount)
         {
-            printf("simplearghandler: Error: %s not found\n", key);
-            PrintAndQuit("");
+            AccessError(parser, SAH_ERROR_NOT_FOUND, "simplearghandler: Error: Invalid handle: %i", handle);
+            return NULL;
         }
+        return parser->argHandles[handle];
+    }
 
-        else if (arg->argType != ARG_BOOL)
+    // Quit if arg doesn't exist, isn't of argType or (when needValue is true) hasn't been set
+    // (key is NULL for handles, the arg's name is used)
+    static Arg* CheckArg(SAH_Parser *parser, Arg *arg, const char *key, int argType, bool needValue)
+    {
+        if (needValue && !CheckParsed(parser)) return NULL;
+        if (key == NULL)
         {
-            printf("simplearghandler: Error: %s is not of type BOOL!\n", key);
-            PrintAndQuit("");
+            // Invalid handle, already reported
+            if (arg == NULL) return NULL;
+            key = arg->longName;
         }
 
-        return arg->value != NULL;
-    }
+        if (arg == NULL || (needValue && arg->value == NULL))
+        {
+            AccessError(parser, SAH_ERROR_NOT_FOUND, "simplearghandler: Error: %s not found", key);
+            return NULL;
+        }
 
-    char GetCharArg(const char *key)
-    {
-        Arg *arg = SearchTable(key);
-        if (!HasArg(key))
+        else if (arg->argType != argType)
         {
-            printf("simplearghandler: Error: %s not found\n", key);
-            PrintAndQuit("");
+            AccessError(parser, SAH_ERROR_TYPE, "simplearghandler: Error: %s is not of type %s!", key, argTypeNames[argType]);
+            return NULL;
         }
 
-        else if (arg->argType != ARG_CHAR)
+        else if (arg->list)
         {
-            printf("simplearghandler: Error: %s is not of type CHAR!\n", key);
-            PrintAndQuit("");
+            AccessError(parser, SAH_ERROR_TYPE, "simplearghandler: Error: %s is a list, use GetArgCount() and Get*ArgAt()!", key);
+            return NULL;
         }
 
-        return ((char *) arg->value)[0];
+        if (!ConvertRaw(parser, arg)) return NULL;
+        return arg;
     }
 
-    const char* GetStringArg(const char *key)
+    // Quit if arg doesn't exist, isn't a list of one of the two types or index is out of range
+    static ArgItem CheckItem(SAH_Parser *parser, Arg *arg, const char *key, int argType, int otherType, int index)
     {
-        Arg *arg = SearchTable(key);
-        if (!HasArg(key))
+        // -1 isn't a valid choice, 0 is
+        ArgItem empty = { 0 };
+        if (argType == ARG_CHOICE) empty.i = -1;
+        if (!CheckParsed(parser)) return empty;
+        if (key == NULL)
         {
-            printf("simplearghandler: Error: %s not found\n", key);
-            PrintAndQuit("");
+            if (arg == NULL) return empty;
+            key = arg->longName;
         }
 
-        else if (arg->argType != ARG_STRING)
+        if (arg == NULL)
+            AccessError(parser, SAH_ERROR_NOT_FOUND, "simplearghandler: Error: %s not found", key);
+
+        else if (!arg->list || (arg->argType != argType && arg->argType != otherType))
+            AccessError(parser, SAH_ERROR_TYPE, "simplearghandler: Error: %s is not a list of type %s!", key, argTypeNames[argType]);
+
+        else if (index < 0 || index >= arg->itemCount)
+            AccessError(parser, SAH_ERROR_NOT_FOUND, "simplearghandler: Error: %s: index %i out of range (count is %i)", key, index, arg->itemCount);
+
+        else
+            return arg->items[index];
+
+        return empty;
+    }
+
+    // Returns true if argument has been set (don't use for bools)
+    bool SAH_HasArg(SAH_Parser *parser, const char *key)
+    {
+        if (!CheckParsed(parser)) return false;
+        Arg *arg = SearchTable(parser, key);
+        if (arg == NULL)
         {
-            printf("simplearghandler: Error: %s is not of type STRING/CHAR*!\n", key);
-            PrintAndQuit("");
+            AccessError(parser, SAH_ERROR_NOT_FOUND, "simplearghandler: Error: %s not found", key);
+            return false;
         }
+        // Lazy values are checked first, so an invalid one is never "set" (and its error shows up here)
+        return ConvertRaw(parser, arg) && IsSet(parser, arg);
+    }
+
+    bool SAH_HasArgH(SAH_Parser *parser, ArgHandle handle)
+    {
+        Arg *arg = HandleToArg(parser, handle);
+        return arg != NULL && ConvertRaw(parser, arg) && IsSet(parser, arg);
+    }
+
+    int SAH_GetIntArg(SAH_Parser *parser, const char *key)
+    {
+        Arg *arg = CheckArg(parser, SearchTable(parser, key), key, ARG_INT, true);
+        return (arg != NULL) ? (int) arg->number.i : 0;
+    }
+
+    int SAH_GetIntArgH(SAH_Parser *parser, ArgHandle handle)
+    {
+        Arg *arg = CheckArg(parser, HandleToArg(parser, handle), NULL, ARG_INT, true);
+        return (arg != NULL) ? (int) arg->number.i : 0;
+    }
+
+    float SAH_GetFloatArg(SAH_Parser *parser, const char *key)
+    {
+        Arg *arg = CheckArg(parser, SearchTable(parser, key), key, ARG_FLOAT, true);
+        return (arg != NULL) ? (float) arg->number.d : 0;
+    }
+
+    float SAH_GetFloatArgH(SAH_Parser *parser, ArgHandle handle)
+    {
+        Arg *arg = CheckArg(parser, HandleToArg(parser, handle), NULL, ARG_FLOAT, true);
+        return (arg != NULL) ? (float) arg->number.d : 0;
+    }
+
+    int64_t SAH_GetInt64Arg(SAH_Parser *parser, const char *key)
+    {
+        Arg *arg = CheckArg(parser, SearchTable(parser, key), key, ARG_INT64, true);
+        return (arg != NULL) ? arg->number.i : 0;
+    }
 
-        return (const char *) arg->value;
+    int64_t SAH_GetInt64ArgH(SAH_Parser *parser, ArgHandle handle)
+    {
+        Arg *arg = CheckArg(parser, HandleToArg(parser, handle), NULL, ARG_INT64, true);
+        return (arg != NULL) ? arg->number.i : 0;
+    }
+
+    uint64_t SAH_GetUInt64Arg(SAH_Parser *parser, const char *key)
+    {
+        Arg *arg = CheckArg(parser, SearchTable(parser, key), key, ARG_UINT64, true);
+        return (arg != NULL) ? arg->number.u : 0;
     }
 
+    uint64_t SAH_GetUInt64ArgH(SAH_Parser *parser, ArgHandle handle)
+    {
+        Arg *arg = CheckArg(parser, HandleToArg(parser, handle), NULL, ARG_UINT64, true);
+        return (arg != NULL) ? arg->number.u : 0;
+    }
+
+    double SAH_GetDoubleArg(SAH_Parser *parser, const char *key)
+    {
+        Arg *arg = CheckArg(parser, SearchTable(parser, key), key, ARG_DOUBLE, true);
+        return (arg != NULL) ? arg->number.d : 0;
+    }
+
+    double SAH_GetDoubleArgH(SAH_Parser *parser, ArgHandle handle)
+    {
+        Arg *arg = CheckArg(parser, HandleToArg(parser, handle), NULL, ARG_DOUBLE, true);
+        return (arg != NULL) ? arg->number.d : 0;
+    }
+
+    // Index of the value given in the arg's choices (see SetArgChoices()), -1 in non-fatal mode if it can't be read
+    int SAH_GetChoiceArg(SAH_Parser *parser, const char *key)
+    {
+        Arg *arg = CheckArg(parser, SearchTable(parser, key), key, ARG_CHOICE, true);
+        return (arg != NULL) ? (int) arg->number.i : -1;
+    }
+
+    int SAH_GetChoiceArgH(SAH_Parser *parser, ArgHandle handle)
+    {
+        Arg *arg = CheckArg(parser, HandleToArg(parser, handle), NULL, ARG_CHOICE, true);
+        return (arg != NULL) ? (int) arg->number.i : -1;
+    }
+
+    // Returns true if arg value is set else false
+    bool SAH_GetBoolArg(SAH_Parser *parser, const char *key)
+    {
+        Arg *arg = CheckArg(parser, SearchTable(parser, key), key, ARG_BOOL, false);
+        return arg != NULL && IsSet(parser, arg);
+    }
+
+    bool SAH_GetBoolArgH(SAH_Parser *parser, ArgHandle handle)
+    {
+        Arg *arg = CheckArg(parser, HandleToArg(parser, handle), NULL, ARG_BOOL, false);
+        return arg != NULL && IsSet(parser, arg);
+    }
+
+    char SAH_GetCharArg(SAH_Parser *parser, const char *key)
+    {
+        Arg *arg = CheckArg(parser, SearchTable(parser, key), key, ARG_CHAR, true);
+        return (arg != NULL) ? ((char *) arg->value)[0] : '\0';
+    }
+
+    char SAH_GetCharArgH(SAH_Parser *parser, ArgHandle handle)
+    {
+        Arg *arg = CheckArg(parser, HandleToArg(parser, handle), NULL, ARG_CHAR, true);
+        return (arg != NULL) ? ((char *) arg->value)[0] : '\0';
+    }
+
+    const char* SAH_GetStringArg(SAH_Parser *parser, const char *key)
+    {
+        Arg *arg = CheckArg(parser, SearchTable(parser, key), key, ARG_STRING, true);
+        return (arg != NULL) ? (const char *) arg->value : NULL;
+    }
+
+    const char* SAH_GetStringArgH(SAH_Parser *parser, ArgHandle handle)
+    {
+        Arg *arg = CheckArg(parser, HandleToArg(parser, handle), NULL, ARG_STRING, true);
+        return (arg != NULL) ? (const char *) arg->value : NULL;
+    }
+
+    // Number of values given for a list arg (0 or 1 for other args)
+    int SAH_GetArgCount(SAH_Parser *parser, const char *key)
+    {
+        if (!CheckParsed(parser)) return 0;
+        Arg *arg = SearchTable(parser, key);
+        if (arg == NULL)
+        {
+            AccessError(parser, SAH_ERROR_NOT_FOUND, "simplearghandler: Error: %s not found", key);
+            return 0;
+        }
+        if (!ConvertRaw(parser, arg)) return 0;
+        return arg->list ? arg->itemCount : IsSet(parser, arg);
+    }
+
+    int SAH_GetArgCountH(SAH_Parser *parser, ArgHandle handle)
+    {
+        Arg *arg = HandleToArg(parser, handle);
+        if (arg == NULL || !ConvertRaw(parser, arg)) return 0;
+        return arg->list ? arg->itemCount : IsSet(parser, arg);
+    }
+
+    // Value at index of a STRING or CHAR list
+    const char* SAH_GetArgAt(SAH_Parser *parser, const char *key, int index)
+    {
+        return CheckItem(parser, SearchTable(parser, key), key, ARG_STRING, ARG_CHAR, index).text;
+    }
+
+    const char* SAH_GetArgAtH(SAH_Parser *parser, ArgHandle handle, int index)
+    {
+        return CheckItem(parser, HandleToArg(parser, handle), NULL, ARG_STRING, ARG_CHAR, index).text;
+    }
+
+    // Value at index of an INT or INT64 list
+    int64_t SAH_GetInt64ArgAt(SAH_Parser *parser, const char *key, int index)
+    {
+        return CheckItem(parser, SearchTable(parser, key), key, ARG_INT64, ARG_INT, index).i;
+    }
+
+    int64_t SAH_GetInt64ArgAtH(SAH_Parser *parser, ArgHandle handle, int index)
+    {
+        return CheckItem(parser, HandleToArg(parser, handle), NULL, ARG_INT64, ARG_INT, index).i;
+    }
+
+    uint64_t SAH_GetUInt64ArgAt(SAH_Parser *parser, const char *key, int index)
+    {
+        return CheckItem(parser, SearchTable(parser, key), key, ARG_UINT64, ARG_UINT64, index).u;
+    }
+
+    uint64_t SAH_GetUInt64ArgAtH(SAH_Parser *parser, ArgHandle handle, int index)
+    {
+        return CheckItem(parser, HandleToArg(parser, handle), NULL, ARG_UINT64, ARG_UINT64, index).u;
+    }
+
+    // Value at index of a FLOAT or DOUBLE list
+    double SAH_GetDoubleArgAt(SAH_Parser *parser, const char *key, int index)
+    {
+        return CheckItem(parser, SearchTable(parser, key), key, ARG_DOUBLE, ARG_FLOAT, index).d;
+    }
+
+    double SAH_GetDoubleArgAtH(SAH_Parser *parser, ArgHandle handle, int index)
+    {
+        return CheckItem(parser, HandleToArg(parser, handle), NULL, ARG_DOUBLE, ARG_FLOAT, index).d;
+    }
+
+    // Value at index of a CHOICE list (as an index in its choices)
+    int SAH_GetChoiceArgAt(SAH_Parser *parser, const char *key, int index)
+    {
+        return (int) CheckItem(parser, SearchTable(parser, key), key, ARG_CHOICE, ARG_CHOICE, index).i;
+    }
+
+    int SAH_GetChoiceArgAtH(SAH_Parser *parser, ArgHandle handle, int index)
+    {
+        return (int) CheckItem(parser, HandleToArg(parser, handle), NULL, ARG_CHOICE, ARG_CHOICE, index).i;
+    }
+
+    // Let a positional STRING list be read from stdin (call before InitArgs()): a "-" value reads values separated by
+    // newlines, and the -0/--stdin0 flag it adds reads NUL separated ones (e.g. from find -print0), also when no value is given.
+    // Read the values with NextInput() or ForEachInput(), which go through the command line values too
+    void SAH_SetStreamArg(SAH_Parser *parser, const char *name)
+    {
+        if (parser->registered)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: SetStreamArg() must be called before InitArgs()");
+        Arg *arg = SearchTable(parser, name);
+        if (arg == NULL || arg->optional || !arg->list || arg->argType != ARG_STRING)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: %s has to be a positional ARG_STRING | ARG_LIST arg to be read from stdin", name);
+        if (parser->streamArg != NULL)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Only one arg can be read from stdin (%s already is)", parser->streamArg->longName);
+
+        char help[SAH_STRING_MAX + 1];
+        snprintf(help, sizeof(help), "Read NUL separated %s from standard input", name);
+        ArgHandle handle = SAH_AddOptionalArg(parser, "0", "stdin0", help, ARG_BOOL);
+        parser->streamArg = arg;
+        parser->stdinArg = parser->argHandles[handle];
+    }
+
+    static void GrowStreamBuffer(SAH_Parser *parser)
+    {
+        size_t size = (parser->streamSize > 0) ? parser->streamSize * 2 : SAH_STREAM_BUFFER;
+        char *buffer = (char *) realloc(parser->streamBuffer, size);
+        SAH_Count(parser, allocations, 1);
+        SAH_Count(parser, allocatedBytes, size);
+        if (buffer == NULL)
+            ArgError(parser, SAH_ERROR_MEMORY, "simplearghandler: Error: Memory allocation failed :(");
+        parser->streamBuffer = buffer;
+        parser->streamSize = size;
+    }
+
+    // Next value of the stream arg (NULL after the last one), length is optional
+    // Values read from stdin live in a reused buffer, so they're only valid until the next call
+    const char* SAH_NextInput(SAH_Parser *parser, size_t *length)
+    {
+        if (!CheckParsed(parser)) return NULL;
+        Arg *arg = parser->streamArg;
+        if (arg == NULL)
+        {
+            AccessError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Call SetStreamArg() before reading inputs");
+            return NULL;
+        }
+
+        for (;;)
+        {
+            if (!parser->streaming)
+            {
+                bool nul = IsSet(parser, parser->stdinArg);
+                // Command line values first, until a "-"
+                if (parser->streamItem < arg->itemCount)
+                {
+                    const char *value = arg->items[parser->streamItem++].text;
+                    if (strcmp(value, "-"))
+                    {
+                        if (length != NULL) *length = strlen(value);
+                        return value;
+                    }
+                    // stdin can only be read once
+                    if (parser->streamDone) continue;
+                }
+                // -0 on its own reads stdin
+                else if (!nul || arg->itemCount > 0 || parser->streamDone)
+                    return NULL;
+
+                parser->streaming = true;
+                parser->streamDelimiter = nul ? '\0' : '\n';
+                if (parser->streamBuffer == NULL) GrowStreamBuffer(parser);
+                continue;
+            }
+
+            // Whole value in the buffer
+            char *start = parser->streamBuffer + parser->streamStart;
+            char *end = (char *) memchr(start, parser->streamDelimiter, parser->streamUsed - parser->streamStart);
+            if (end != NULL || (parser->streamEnd && parser->streamStart < parser->streamUsed))
+            {
+                // Last value doesn't need a delimiter after it (there's always room for the '\0')
+                if (end == NULL) end = parser->streamBuffer + parser->streamUsed;
+                *end = '\0';
+                parser->streamStart = (size_t) (end - parser->streamBuffer) + 1;
+                if (parser->streamStart > parser->streamUsed) parser->streamStart = parser->streamUsed;
+                if (length != NULL) *length = (size_t) (end - start);
+                return start;
+            }
+            // stdin is used up, carry on with the command line values
+            if (parser->streamEnd)
+            {
+                parser->streaming = false;
+                parser->streamDone = true;
+                continue;
+            }
+
+            // Move the unfinished value to the front, grow only if it fills the whole buffer
+            memmove(parser->streamBuffer, start, parser->streamUsed - parser->streamStart);
+            parser->streamUsed -= parser->streamStart;
+            parser->streamStart = 0;
+            if (parser->streamUsed + 1 >= parser->streamSize) GrowStreamBuffer(parser);
+
+            // Leave a byte for the '\0' after the last value
+            #ifdef SAH_USE_MMAP
+                ssize_t bytes = read(STDIN_FILENO, parser->streamBuffer + parser->streamUsed, parser->streamSize - parser->streamUsed - 1);
+                if (bytes < 0 && errno == EINTR) continue;
+            #else
+                long bytes = (long) fread(parser->streamBuffer + parser->streamUsed, 1, parser->streamSize - parser->streamUsed - 1, stdin);
+            #endif
+            if (bytes <= 0) parser->streamEnd = true;
+            else parser->streamUsed += (size_t) bytes;
+        }
+    }
+
+    // Call callback with every value of the stream arg (until it returns false), returns how many it got
+    long SAH_ForEachInput(SAH_Parser *parser, SAH_InputCallback callback, void *data)
+    {
+        long count = 0;
+        size_t length;
+        for (const char *value; (value = SAH_NextInput(parser, &length)) != NULL; )
+        {
+            count++;
+            if (!callback(value, length, data)) break;
+        }
+        return count;
+    }
+
+    // Hash of every registered arg's names and type, so a snapshot is only loaded by a parser with the same args
+    static uint32_t SchemaHash(SAH_Parser *parser)
+    {
+        uint32_t hash = HashName("", 0);
+        for (int i = 0; i < parser->argCount; i++)
+        {
+            Arg *arg = parser->argHandles[i];
+            hash = (hash ^ HashName(arg->shortName, strlen(arg->shortName))) * 16777619u;
+            hash = (hash ^ HashName(arg->longName, strlen(arg->longName))) * 16777619u;
+            hash = (hash ^ (uint32_t) (arg->argType | (arg->list ? ARG_LIST : 0) | (arg->count ? ARG_COUNT : 0) | (arg->optional ? 0x10000 : 0))) * 16777619u;
+            // Choices are stored as indexes, so they have to be the same (and in the same order)
+            if (arg->choiceText != NULL) hash = (hash ^ HashName(arg->choiceText, strlen(arg->choiceText))) * 16777619u;
+        }
+        return hash;
+    }
+
+    // Copy text (with its '\0') to out at *offset, return where it went
+    static uint64_t PutSnapshotString(unsigned char *out, size_t *offset, const char *text)
+    {
+        size_t length = strlen(text) + 1;
+        uint64_t start = *offset;
+        memcpy(out + *offset, text, length);
+        *offset += length;
+        return start;
+    }
+
+    // Write the parsed values to buffer as one block without pointers (header, bool bits, one entry per arg, list items, strings),
+    // so it can go through a pipe, file or shared memory to LoadArgs() in another process
+    // Returns the bytes needed, nothing is written if size is smaller (call with NULL, 0 to get the size)
+    size_t SAH_SerializeArgs(SAH_Parser *parser, void *buffer, size_t size)
+    {
+        if (!CheckParsed(parser)) return 0;
+
+        size_t boolWords = (parser->boolCount + 63) / 64, itemCount = 0;
+        size_t stringBytes = strlen(parser->appName) + 1 + ((parser->command != NULL) ? strlen(parser->command->name) : 0) + 1;
+        for (int i = 0; i < parser->argCount; i++)
+        {
+            Arg *arg = parser->argHandles[i];
+            // Lazy values are converted now, so the snapshot only has finished values
+            if (!ConvertRaw(parser, arg) || arg->value == NULL || arg->argType == ARG_BOOL) continue;
+
+            bool text = arg->argType == ARG_STRING || arg->argType == ARG_CHAR;
+            if (arg->list)
+            {
+                itemCount += arg->itemCount;
+                for (int j = 0; text && j < arg->itemCount; j++) stringBytes += strlen(arg->items[j].text) + 1;
+            }
+            else if (text)
+                stringBytes += strlen((const char *) arg->value) + 1;
+        }
+
+        size_t entriesStart = sizeof(ArgSnapshotHeader) + boolWords * sizeof(uint64_t);
+        size_t itemsStart = entriesStart + parser->argCount * sizeof(ArgSnapshotEntry);
+        size_t stringsStart = itemsStart + itemCount * sizeof(uint64_t);
+        // Ends on a '\0' and a multiple of 8 bytes, so snapshots can be stored back to back
+        size_t total = (stringsStart + stringBytes + 7) / 8 * 8;
+        if (total > UINT32_MAX)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Parsed values are too big for a snapshot");
+        if (buffer == NULL || size < total) return total;
+
+        unsigned char *out = (unsigned char *) buffer;
+        memset(out, 0, total);
+        size_t items = itemsStart, strings = stringsStart;
+
+        ArgSnapshotHeader header = { SAH_SNAPSHOT_MAGIC, SAH_SNAPSHOT_VERSION, (uint32_t) total, SchemaHash(parser),
+                                     (uint32_t) parser->argCount, (uint32_t) parser->boolCount, 0, 0 };
+        header.appName = (uint32_t) PutSnapshotString(out, &strings, parser->appName);
+        header.command = (uint32_t) PutSnapshotString(out, &strings, (parser->command != NULL) ? parser->command->name : "");
+        memcpy(out, &header, sizeof(header));
+        memcpy(out + sizeof(header), parser->boolBits, boolWords * sizeof(uint64_t));
+
+        for (int i = 0; i < parser->argCount; i++)
+        {
+            Arg *arg = parser->argHandles[i];
+            ArgSnapshotEntry entry = { 0, 0, 0 };
+            bool text = arg->argType == ARG_STRING || arg->argType == ARG_CHAR;
+
+            if (arg->value != NULL && arg->argType != ARG_BOOL && arg->list)
+            {
+                entry.count = (uint32_t) arg->itemCount;
+                entry.value = items;
+                for (int j = 0; j < arg->itemCount; j++, items += sizeof(uint64_t))
+                {
+                    uint64_t value = text ? PutSnapshotString(out, &strings, arg->items[j].text) : arg->items[j].u;
+                    memcpy(out + items, &value, sizeof(value));
+                }
+            }
+            else if (arg->value != NULL && arg->argType != ARG_BOOL)
+            {
+                entry.count = 1;
+                entry.value = text ? PutSnapshotString(out, &strings, (const char *) arg->value) : arg->number.u;
+            }
+
+            memcpy(out + entriesStart + i * sizeof(ArgSnapshotEntry), &entry, sizeof(entry));
+        }
+
+        return total;
+    }
+
+    static void SnapshotError(SAH_Parser *parser, const char *reason)
+    {
+        ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Can't load snapshot: %s", reason);
+    }
+
+    // Use instead of InitArgs() in a process that got a SerializeArgs() snapshot: add the same args (and commands), then load.
+    // Nothing is parsed: numbers and bools are copied and strings point into the snapshot, so it has to stay
+    // (unchanged) until FreeArgs(). The only allocation is one array per list
+    void SAH_LoadArgs(SAH_Parser *parser, const void *snapshot, size_t size, const char *appDescription)
+    {
+        if (parser->initialised)
+            ArgError(parser, SAH_ERROR_USAGE, "simplearghandler: Error: Can't initialise more than once");
+
+        const unsigned char *base = (const unsigned char *) snapshot;
+        ArgSnapshotHeader header;
+        if (base == NULL || size < sizeof(header) || base[size - 1] != '\0') SnapshotError(parser, "not a snapshot");
+        memcpy(&header, base, sizeof(header));
+        if (header.magic != SAH_SNAPSHOT_MAGIC || header.version != SAH_SNAPSHOT_VERSION) SnapshotError(parser, "not a snapshot");
+        // Snapshot ends on '\0', so every string inside it is terminated
+        if (header.size != size || header.appName >= size || header.command >= size) SnapshotError(parser, "snapshot is damaged");
+
+        snprintf(parser->appDesc, sizeof(parser->appDesc), "%s", appDescription);
+        snprintf(parser->appName, sizeof(parser->appName), "%s", (const char *) base + header.appName);
+
+        // Same command as the process that wrote it, so the same args get added
+        if (parser->commands != NULL)
+        {
+            const char *name = (const char *) base + header.command;
+            ArgCommand *command = parser->commands;
+            for (; command != NULL && strcmp(command->name, name); command = command->next);
+            if (command == NULL)
+                ArgError(parser, SAH_ERROR_COMMAND, "%s: Error: Unknown command: %s", parser->appName, name);
+
+            parser->command = command;
+            parser->globalCount = parser->argCount;
+            snprintf(parser->appDesc, sizeof(parser->appDesc), "%s", command->help);
+            if (command->setup != NULL) command->setup(parser);
+            // Long names were looked up before the command's args (and help) were added
+            parser->trie = NULL;
+        }
+        EndRegistration(parser);
+
+        size_t boolWords = (parser->boolCount + 63) / 64, entriesStart = sizeof(header) + boolWords * sizeof(uint64_t);
+        if (header.argCount != (uint32_t) parser->argCount || header.boolCount != (uint32_t) parser->boolCount || header.schema != SchemaHash(parser))
+            SnapshotError(parser, "it was written by an app with different arguments");
+        if (entriesStart + parser->argCount * sizeof(ArgSnapshotEntry) > size) SnapshotError(parser, "snapshot is damaged");
+
+        memcpy(parser->boolBits, base + sizeof(header), boolWords * sizeof(uint64_t));
+        for (int i = 0; i < parser->argCount; i++)
+        {
+            Arg *arg = parser->argHandles[i];
+            ArgSnapshotEntry entry;
+            memcpy(&entry, base + entriesStart + i * sizeof(ArgSnapshotEntry), sizeof(entry));
+            if (entry.count == 0 || arg->argType == ARG_BOOL) continue;
+
+            bool text = arg->argType == ARG_STRING || arg->argType == ARG_CHAR;
+            if (arg->list)
+            {
+                if (entry.value > size || entry.count > (size - entry.value) / sizeof(uint64_t)) SnapshotError(parser, "snapshot is damaged");
+                ArgItem *items = (ArgItem *) realloc(arg->items, entry.count * sizeof(ArgItem));
+                SAH_Count(parser, allocations, 1);
+                SAH_Count(parser, allocatedBytes, entry.count * sizeof(ArgItem));
+                if (items == NULL)
+                    ArgError(parser, SAH_ERROR_MEMORY, "simplearghandler: Error: Memory allocation failed :(");
+
+                for (uint32_t j = 0; j < entry.count; j++)
+                {
+                    uint64_t value;
+                    memcpy(&value, base + entry.value + j * sizeof(uint64_t), sizeof(value));
+                    if ((text && value >= size) || (arg->argType == ARG_CHOICE && value >= (uint64_t) arg->choiceCount)) SnapshotError(parser, "snapshot is damaged");
+                    if (text) items[j].text = (const char *) base + value;
+                    else items[j].u = value;
+                }
+                arg->items = items;
+                arg->itemCount = arg->itemCapacity = (int) entry.count;
+                arg->value = arg->items;
+            }
+            else if (text)
+            {
+                if (entry.value >= size) SnapshotError(parser, "snapshot is damaged");
+                arg->value = (void *) (base + entry.value);
+            }
+            else
+            {
+                if (arg->argType == ARG_CHOICE && entry.value >= (uint64_t) arg->choiceCount) SnapshotError(parser, "snapshot is damaged");
+                arg->number.u = entry.value;
+                arg->value = &arg->number;
+            }
+        }
+
+        parser->initialised = true;
+    }
+
+    static size_t CacheLineRound(size_t size)
+    {
+        return (size + SAH_CACHE_LINE - 1) / SAH_CACHE_LINE * SAH_CACHE_LINE;
+    }
+
+    // Copy every parsed value into one immutable block: values by handle, presence bits, list items and strings,
+    // each starting on a cache line. Nothing in it points into the parser, so it stays valid after ParseArgs() or
+    // FreeArgs(), and any number of threads can read it with SAH_Frozen*() without locks, lookups or errors
+    // Free it with SAH_FreeFrozenArgs() (NULL before InitArgs(), in non-fatal mode)
+    const SAH_FrozenArgs* SAH_FreezeArgs(SAH_Parser *parser)
+    {
+        if (!parser->initialised)
+        {
+            AccessError(parser, SAH_ERROR_NOT_PARSED, "simplearghandler: Error: Call InitArgs() before FreezeArgs()!");
+            return NULL;
+        }
+
+        size_t itemCount = 0, stringBytes = 0;
+        for (int i = 0; i < parser->argCount; i++)
+        {
+            Arg *arg = parser->argHandles[i];
+            // Lazy values are converted now (invalid ones count as not given, in non-fatal mode)
+            if (!ConvertRaw(parser, arg) || arg->value == NULL || arg->argType == ARG_BOOL) continue;
+
+            bool text = arg->argType == ARG_STRING || arg->argType == ARG_CHAR;
+            if (arg->list)
+            {
+                itemCount += arg->itemCount;
+                for (int j = 0; text && j < arg->itemCount; j++) stringBytes += strlen(arg->items[j].text) + 1;
+            }
+            else if (text)
+                stringBytes += strlen((const char *) arg->value) + 1;
+        }
+
+        size_t valuesStart = CacheLineRound(sizeof(SAH_FrozenArgs));
+        size_t presentStart = valuesStart + CacheLineRound(parser->argCount * sizeof(ArgItem));
+        size_t countsStart = presentStart + CacheLineRound((parser->argCount + 63) / 64 * sizeof(uint64_t));
+        size_t itemsStart = countsStart + CacheLineRound(parser->argCount * sizeof(int));
+        size_t stringsStart = itemsStart + CacheLineRound(itemCount * sizeof(ArgItem));
+        size_t size = stringsStart + stringBytes;
+
+        // Room to move the block up to the next cache line
+        char *allocation = (char *) calloc(1, size + SAH_CACHE_LINE);
+        SAH_Count(parser, allocations, 1);
+        SAH_Count(parser, allocatedBytes, size + SAH_CACHE_LINE);
+        if (allocation == NULL)
+            ArgError(parser, SAH_ERROR_MEMORY, "simplearghandler: Error: Memory allocation failed :(");
+        char *block = allocation + (SAH_CACHE_LINE - (uintptr_t) allocation % SAH_CACHE_LINE) % SAH_CACHE_LINE;
+
+        ArgItem *values = (ArgItem *) (block + valuesStart), *items = (ArgItem *) (block + itemsStart);
+        uint64_t *present = (uint64_t *) (block + presentStart);
+        int *itemCounts = (int *) (block + countsStart);
+        char *strings = block + stringsStart;
+        size_t itemNext = 0;
+
+        for (int i = 0; i < parser->argCount; i++)
+        {
+            Arg *arg = parser->argHandles[i];
+            // -1 isn't a valid choice, so a choice is read without its bit
+            if (arg->argType == ARG_CHOICE) values[i].i = -1;
+            if (!IsSet(parser, arg)) continue;
+
+            // Bools are only their bit
+            present[i / 64] |= (uint64_t) 1 << (i % 64);
+            if (arg->argType == ARG_BOOL) continue;
+
+            bool text = arg->argType == ARG_STRING || arg->argType == ARG_CHAR;
+            if (arg->list)
+            {
+                values[i].i = (int64_t) itemNext;
+                itemCounts[i] = arg->itemCount;
+                for (int j = 0; j < arg->itemCount; j++, itemNext++)
+                {
+                    items[itemNext] = arg->items[j];
+                    if (!text) continue;
+                    size_t length = strlen(arg->items[j].text) + 1;
+                    items[itemNext].text = (const char *) memcpy(strings, arg->items[j].text, length);
+                    strings += length;
+                }
+            }
+            else if (text)
+            {
+                size_t length = strlen((const char *) arg->value) + 1;
+                values[i].text = (const char *) memcpy(strings, arg->value, length);
+                strings += length;
+            }
+            else
+                values[i] = arg->number;
+        }
+
+        SAH_FrozenArgs *frozen = (SAH_FrozenArgs *) block;
+        frozen->values = values;
+        frozen->present = present;
+        frozen->itemCounts = itemCounts;
+        frozen->items = items;
+        frozen->argCount = parser->argCount;
+        frozen->allocation = allocation;
+        return frozen;
+    }
+
+    void SAH_FreeFrozenArgs(const SAH_FrozenArgs *frozen)
+    {
+        if (frozen != NULL) free(frozen->allocation);
+    }
+
+    // Readers of a frozen block: one load each, handles aren't checked and the member read has to match the arg's type
+    // (not given: 0, false or NULL)
+    static inline bool SAH_FrozenHas(const SAH_FrozenArgs *frozen, ArgHandle handle)
+    {
+        return (frozen->present[handle / 64] >> (handle % 64)) & 1;
+    }
+
+    static inline bool SAH_FrozenBool(const SAH_FrozenArgs *frozen, ArgHandle handle)
+    {
+        return SAH_FrozenHas(frozen, handle);
+    }
+
+    static inline int SAH_FrozenInt(const SAH_FrozenArgs *frozen, ArgHandle handle)
+    {
+        return (int) frozen->values[handle].i;
+    }
+
+    static inline int64_t SAH_FrozenInt64(const SAH_FrozenArgs *frozen, ArgHandle handle)
+    {
+        return frozen->values[handle].i;
+    }
+
+    static inline uint64_t SAH_FrozenUInt64(const SAH_FrozenArgs *frozen, ArgHandle handle)
+    {
+        return frozen->values[handle].u;
+    }
+
+    static inline float SAH_FrozenFloat(const SAH_FrozenArgs *frozen, ArgHandle handle)
+    {
+        return (float) frozen->values[handle].d;
+    }
+
+    static inline double SAH_FrozenDouble(const SAH_FrozenArgs *frozen, ArgHandle handle)
+    {
+        return frozen->values[handle].d;
+    }
+
+    static inline char SAH_FrozenChar(const SAH_FrozenArgs *frozen, ArgHandle handle)
+    {
+        return (frozen->values[handle].text != NULL) ? frozen->values[handle].text[0] : '\0';
+    }
+
+    static inline const char* SAH_FrozenString(const SAH_FrozenArgs *frozen, ArgHandle handle)
+    {
+        return frozen->values[handle].text;
+    }
+
+    static inline int SAH_FrozenChoice(const SAH_FrozenArgs *frozen, ArgHandle handle)
+    {
+        return (int) frozen->values[handle].i;
+    }
+
+    // Values in a list, the one at index (index isn't checked either)
+    static inline int SAH_FrozenCount(const SAH_FrozenArgs *frozen, ArgHandle handle)
+    {
+        return frozen->itemCounts[handle];
+    }
+
+    static inline ArgItem SAH_FrozenAt(const SAH_FrozenArgs *frozen, ArgHandle handle, int index)
+    {
+        return frozen->items[frozen->values[handle].i + index];
+    }
+
+    // Functions using the default parser (not thread safe, use the SAH_ versions with your own parser for that)
+    void FreeArgs(void)
+    {
+        SAH_FreeArgs(&sahDefaultParser);
+    }
+
+    void SetArgBuffer(void *buffer, size_t size)
+    {
+        SAH_SetArgBuffer(&sahDefaultParser, buffer, size);
+    }
+
+    void SetLazyArgs(bool lazy)
+    {
+        SAH_SetLazyArgs(&sahDefaultParser, lazy);
+    }
+
+    void SetResponseFiles(bool enabled)
+    {
+        SAH_SetResponseFiles(&sahDefaultParser, enabled);
+    }
+
+    void SetCompletion(bool enabled)
+    {
+        SAH_SetCompletion(&sahDefaultParser, enabled);
+    }
+
+    // setup gets the default parser, so it can use the functions without a parser argument
+    void AddCommand(const char *name, const char *help, SAH_CommandSetup setup)
+    {
+        SAH_AddCommand(&sahDefaultParser, name, help, setup);
+    }
+
+    const char* GetCommand(void)
+    {
+        return SAH_GetCommand(&sahDefaultParser);
+    }
+
+    void SetErrorBuffer(char *buffer, size_t size)
+    {
+        SAH_SetErrorBuffer(&sahDefaultParser, buffer, size);
+    }
+
+    int GetArgError(void)
+    {
+        return SAH_GetArgError(&sahDefaultParser);
+    }
+
+    int TryInitArgs(int argc, const char* argv[], const char* appDescription)
+    {
+        return SAH_TryInitArgs(&sahDefaultParser, argc, argv, appDescription);
+    }
+
+    int TryParseArgs(int argc, const char* argv[])
+    {
+        return SAH_TryParseArgs(&sahDefaultParser, argc, argv);
+    }
+
+    void SetArgAction(ArgHandle handle, SAH_ArgAction action, void *data)
+    {
+        SAH_SetArgAction(&sahDefaultParser, handle, action, data);
+    }
+
+    void SetArgChoices(ArgHandle handle, const char *choices[], int count)
+    {
+        SAH_SetArgChoices(&sahDefaultParser, handle, choices, count);
+    }
+
+    void SetStreamArg(const char *name)
+    {
+        SAH_SetStreamArg(&sahDefaultParser, name);
+    }
+
+    const char* NextInput(size_t *length)
+    {
+        return SAH_NextInput(&sahDefaultParser, length);
+    }
+
+    long ForEachInput(SAH_InputCallback callback, void *data)
+    {
+        return SAH_ForEachInput(&sahDefaultParser, callback, data);
+    }
+
+    size_t SerializeArgs(void *buffer, size_t size)
+    {
+        return SAH_SerializeArgs(&sahDefaultParser, buffer, size);
+    }
+
+    void LoadArgs(const void *snapshot, size_t size, const char *appDescription)
+    {
+        SAH_LoadArgs(&sahDefaultParser, snapshot, size, appDescription);
+    }
+
+    const SAH_FrozenArgs* FreezeArgs(void)
+    {
+        return SAH_FreezeArgs(&sahDefaultParser);
+    }
+
+    ArgHandle AddOptionalArg(const char *shortName, const char *longName, const char *help, int argType)
+    {
+        return SAH_AddOptionalArg(&sahDefaultParser, shortName, longName, help, argType);
+    }
+
+    ArgHandle AddPositionalArg(const char *name, const char *help, int argType)
+    {
+        return SAH_AddPositionalArg(&sahDefaultParser, name, help, argType);
+    }
+
+    void InitArgs(int argc, const char* argv[], const char* appDescription)
+    {
+        SAH_InitArgs(&sahDefaultParser, argc, argv, appDescription);
+    }
+
+    void ResetArgs(void)
+    {
+        SAH_ResetArgs(&sahDefaultParser);
+    }
+
+    void ParseArgs(int argc, const char* argv[])
+    {
+        SAH_ParseArgs(&sahDefaultParser, argc, argv);
+    }
+
+    bool HasArg(const char *key)
+    {
+        return SAH_HasArg(&sahDefaultParser, key);
+    }
+
+    bool HasArgH(ArgHandle handle)
+    {
+        return SAH_HasArgH(&sahDefaultParser, handle);
+    }
+
+    int GetIntArg(const char *key)
+    {
+        return SAH_GetIntArg(&sahDefaultParser, key);
+    }
+
+    int GetIntArgH(ArgHandle handle)
+    {
+        return SAH_GetIntArgH(&sahDefaultParser, handle);
+    }
+
+    float GetFloatArg(const char *key)
+    {
+        return SAH_GetFloatArg(&sahDefaultParser, key);
+    }
+
+    float GetFloatArgH(ArgHandle handle)
+    {
+        return SAH_GetFloatArgH(&sahDefaultParser, handle);
+    }
+
+    int64_t GetInt64Arg(const char *key)
+    {
+        return SAH_GetInt64Arg(&sahDefaultParser, key);
+    }
+
+    int64_t GetInt64ArgH(ArgHandle handle)
+    {
+        return SAH_GetInt64ArgH(&sahDefaultParser, handle);
+    }
+
+    uint64_t GetUInt64Arg(const char *key)
+    {
+        return SAH_GetUInt64Arg(&sahDefaultParser, key);
+    }
+
+    uint64_t GetUInt64ArgH(ArgHandle handle)
+    {
+        return SAH_GetUInt64ArgH(&sahDefaultParser, handle);
+    }
+
+    double GetDoubleArg(const char *key)
+    {
+        return SAH_GetDoubleArg(&sahDefaultParser, key);
+    }
+
+    double GetDoubleArgH(ArgHandle handle)
+    {
+        return SAH_GetDoubleArgH(&sahDefaultParser, handle);
+    }
+
+    int GetChoiceArg(const char *key)
+    {
+        return SAH_GetChoiceArg(&sahDefaultParser, key);
+    }
+
+    int GetChoiceArgH(ArgHandle handle)
+    {
+        return SAH_GetChoiceArgH(&sahDefaultParser, handle);
+    }
+
+    bool GetBoolArg(const char *key)
+    {
+        return SAH_GetBoolArg(&sahDefaultParser, key);
+    }
+
+    bool GetBoolArgH(ArgHandle handle)
+    {
+        return SAH_GetBoolArgH(&sahDefaultParser, handle);
+    }
+
+    char GetCharArg(const char *key)
+    {
+        return SAH_GetCharArg(&sahDefaultParser, key);
+    }
+
+    char GetCharArgH(ArgHandle handle)
+    {
+        return SAH_GetCharArgH(&sahDefaultParser, handle);
+    }
+
+    const char* GetStringArg(const char *key)
+    {
+        return SAH_GetStringArg(&sahDefaultParser, key);
+    }
+
+    const char* GetStringArgH(ArgHandle handle)
+    {
+        return SAH_GetStringArgH(&sahDefaultParser, handle);
+    }
+
+    int GetArgCount(const char *key)
+    {
+        return SAH_GetArgCount(&sahDefaultParser, key);
+    }
+
+    int GetArgCountH(ArgHandle handle)
+    {
+        return SAH_GetArgCountH(&sahDefaultParser, handle);
+    }
+
+    const char* GetArgAt(const char *key, int index)
+    {
+        return SAH_GetArgAt(&sahDefaultParser, key, index);
+    }
+
+    const char* GetArgAtH(ArgHandle handle, int index)
+    {
+        return SAH_GetArgAtH(&sahDefaultParser, handle, index);
+    }
+
+    int64_t GetInt64ArgAt(const char *key, int index)
+    {
+        return SAH_GetInt64ArgAt(&sahDefaultParser, key, index);
+    }
+
+    int64_t GetInt64ArgAtH(ArgHandle handle, int index)
+    {
+        return SAH_GetInt64ArgAtH(&sahDefaultParser, handle, index);
+    }
+
+    uint64_t GetUInt64ArgAt(const char *key, int index)
+    {
+        return SAH_GetUInt64ArgAt(&sahDefaultParser, key, index);
+    }
+
+    uint64_t GetUInt64ArgAtH(ArgHandle handle, int index)
+    {
+        return SAH_GetUInt64ArgAtH(&sahDefaultParser, handle, index);
+    }
+
+    double GetDoubleArgAt(const char *key, int index)
+    {
+        return SAH_GetDoubleArgAt(&sahDefaultParser, key, index);
+    }
+
+    double GetDoubleArgAtH(ArgHandle handle, int index)
+    {
+        return SAH_GetDoubleArgAtH(&sahDefaultParser, handle, index);
+    }
+
+    int GetChoiceArgAt(const char *key, int index)
+    {
+        return SAH_GetChoiceArgAt(&sahDefaultParser, key, index);
+    }
+
+    int GetChoiceArgAtH(ArgHandle handle, int index)
+    {
+        return SAH_GetChoiceArgAtH(&sahDefaultParser, handle, index);
+    }
+
+    #ifdef SAH_STATS
+        SAH_ArgStats GetArgStats(void)
+        {
+            return SAH_GetArgStats(&sahDefaultParser);
+        }
+
+        void PrintArgStats(FILE *stream)
+        {
+            SAH_PrintArgStats(&sahDefaultParser, stream);
+        }
+    #endif
+
 #endif
\ No newline at end of file
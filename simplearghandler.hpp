@@ -0,0 +1,262 @@
+#ifndef SIMPLE_ARG_HANDLER_HPP
+#define SIMPLE_ARG_HANDLER_HPP
+
+    // C++20 front-end: args are declared as a type, checked at compile time, parsed by the C parser (same rules, errors and
+    // help) and then read without any lookup
+    //
+    //  using CatArgs = sah::Args<sah::Positional<"File path", "Path to file", const char*>,
+    //                            sah::Optional<"l", "max-lines", "Show a specified number of lines", int>>;
+    //  CatArgs args(argc, argv, "Concatenate a file to standard output");
+    //  if (args.has<"l">()) maxLines = args.get<"max-lines">();
+
+    #include "simplearghandler.h"
+    #include <array>
+    #include <cstddef>
+    #include <cstdint>
+    #include <string_view>
+    #include <tuple>
+    #include <type_traits>
+    #include <utility>
+
+    namespace sah
+    {
+        // String literal as a template argument
+        template <std::size_t N>
+        struct Name
+        {
+            char text[N] {};
+
+            constexpr Name(const char (&name)[N])
+            {
+                for (std::size_t i = 0; i < N; i++) text[i] = name[i];
+            }
+
+            constexpr std::string_view View() const { return std::string_view(text, N - 1); }
+        };
+
+        // Same as AddOptionalArg(shortName, longName, help, type)
+        template <Name ShortName, Name LongName, Name Help, typename T>
+        struct Optional
+        {
+            using Type = T;
+            static constexpr std::string_view shortName = ShortName.View(), longName = LongName.View(), help = Help.View();
+            static constexpr bool optional = true;
+        };
+
+        // Same as AddPositionalArg(name, help, type), positional args are in the order they are declared
+        template <Name LongName, Name Help, typename T>
+        struct Positional
+        {
+            using Type = T;
+            static constexpr std::string_view shortName = "", longName = LongName.View(), help = Help.View();
+            static constexpr bool optional = false;
+        };
+
+        // Same as ARG_INT | ARG_COUNT: get<>() is how many times it was given
+        struct Count {};
+
+        // Same as ARG_CHOICE with SetArgChoices(): get<>() is the index of the value given
+        template <Name... Choices>
+        struct Choice
+        {
+            static constexpr std::array<std::string_view, sizeof...(Choices)> views { Choices.View()... };
+            static constexpr const char *texts[] = { Choices.text... };
+        };
+
+        // Argument type (from the C enum) for each supported C++ type
+        template <typename T> inline constexpr int argTypeOf = -1;
+        template <> inline constexpr int argTypeOf<bool> = ARG_BOOL;
+        template <> inline constexpr int argTypeOf<int> = ARG_INT;
+        template <> inline constexpr int argTypeOf<float> = ARG_FLOAT;
+        template <> inline constexpr int argTypeOf<char> = ARG_CHAR;
+        template <> inline constexpr int argTypeOf<const char*> = ARG_STRING;
+        template <> inline constexpr int argTypeOf<double> = ARG_DOUBLE;
+        template <> inline constexpr int argTypeOf<int64_t> = ARG_INT64;
+        template <> inline constexpr int argTypeOf<uint64_t> = ARG_UINT64;
+        template <> inline constexpr int argTypeOf<Count> = ARG_INT | ARG_COUNT;
+        template <Name... Choices> inline constexpr int argTypeOf<Choice<Choices...>> = ARG_CHOICE;
+
+        // What get<>() returns for each type (counts and choices are ints)
+        template <typename T> struct ValueOf { using Type = T; };
+        template <> struct ValueOf<Count> { using Type = int; };
+        template <Name... Choices> struct ValueOf<Choice<Choices...>> { using Type = int; };
+
+        // Parsed value and whether it was given
+        template <typename T>
+        struct Value
+        {
+            T value {};
+            bool set = false;
+        };
+
+        template <typename... Options>
+        class Args
+        {
+            static constexpr std::size_t count = sizeof...(Options);
+            static constexpr std::array<std::string_view, count> shortNames { Options::shortName... };
+            static constexpr std::array<std::string_view, count> longNames { Options::longName... };
+            static constexpr std::array<std::string_view, count> helps { Options::help... };
+            static constexpr std::array<bool, count> optionals { Options::optional... };
+            static constexpr std::array<int, count> argTypes { argTypeOf<typename Options::Type>... };
+
+            static constexpr bool IsAlnum(char ch)
+            {
+                return (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+            }
+
+            // Compile-time versions of the checks AddOptionalArg()/AddPositionalArg() do at runtime
+            static constexpr bool TypesSupported()
+            {
+                for (std::size_t i = 0; i < count; i++)
+                    if (argTypes[i] < 0 || ((argTypes[i] & ARG_COUNT) && !optionals[i])) return false;
+                return true;
+            }
+
+            static constexpr bool NamesFit()
+            {
+                for (std::size_t i = 0; i < count; i++)
+                    if (shortNames[i].size() > SAH_SHORT_NAME_MAX || longNames[i].size() > SAH_LONG_NAME_MAX || helps[i].size() > SAH_STRING_MAX)
+                        return false;
+                return true;
+            }
+
+            static constexpr bool NamesValid()
+            {
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    if (longNames[i].empty() || !IsAlnum(longNames[i][0])) return false;
+                    if (optionals[i] && (shortNames[i].empty() || !IsAlnum(shortNames[i][0]))) return false;
+                    if (optionals[i] && (shortNames[i].find(' ') != std::string_view::npos || longNames[i].find(' ') != std::string_view::npos)) return false;
+                }
+                return true;
+            }
+
+            // Same rule as the C index: no name (short or long) belongs to two args, an arg's own short and long name can match
+            static constexpr bool NoDuplicates()
+            {
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    // -h/--help is added by the parser
+                    if (shortNames[i] == "h" || longNames[i] == "h" || shortNames[i] == "help" || longNames[i] == "help") return false;
+                    for (std::size_t j = i + 1; j < count; j++)
+                    {
+                        std::string_view names[] = { shortNames[i], longNames[i] }, others[] = { shortNames[j], longNames[j] };
+                        for (std::string_view name : names)
+                            for (std::string_view other : others)
+                                if (!name.empty() && name == other) return false;
+                    }
+                }
+                return true;
+            }
+
+            // Choices can't be empty or given twice (SetArgChoices() checks the same at runtime)
+            template <typename T>
+            static constexpr bool ChoicesValid()
+            {
+                if constexpr (argTypeOf<T> == ARG_CHOICE)
+                {
+                    for (std::size_t i = 0; i < T::views.size(); i++)
+                    {
+                        if (T::views[i].empty()) return false;
+                        for (std::size_t j = i + 1; j < T::views.size(); j++)
+                            if (T::views[i] == T::views[j]) return false;
+                    }
+                }
+                return true;
+            }
+
+            static_assert(TypesSupported(), "simplearghandler: Unsupported type (use bool, int, float, char, const char*, double, int64_t, uint64_t, Count or Choice, Count only for Optional)");
+            static_assert(NamesFit(), "simplearghandler: Name or help text is too long");
+            static_assert(NamesValid(), "simplearghandler: Names can't be empty and should only contain letters and numbers, and no spaces");
+            static_assert(NoDuplicates(), "simplearghandler: Duplicate name (h/help is reserved)");
+            static_assert((ChoicesValid<typename Options::Type>() && ...), "simplearghandler: Choices can't be empty or given twice");
+
+            // Index of a short or long name, resolved at compile time by get<>()/has<>()
+            static consteval std::size_t Find(std::string_view key)
+            {
+                for (std::size_t i = 0; i < count; i++)
+                    if (key == shortNames[i] || key == longNames[i]) return i;
+                return count;
+            }
+
+            std::tuple<Value<typename ValueOf<typename Options::Type>::Type>...> values;
+
+            // Add arg I to the parser (its handle is I, args get handles in the order they're added)
+            template <std::size_t I>
+            static void AddArg(SAH_Parser *parser)
+            {
+                using T = std::tuple_element_t<I, std::tuple<typename Options::Type...>>;
+                if (optionals[I]) SAH_AddOptionalArg(parser, shortNames[I].data(), longNames[I].data(), helps[I].data(), argTypes[I]);
+                else SAH_AddPositionalArg(parser, longNames[I].data(), helps[I].data(), argTypes[I]);
+
+                if constexpr (argTypeOf<T> == ARG_CHOICE)
+                    SAH_SetArgChoices(parser, (ArgHandle) I, const_cast<const char **>(T::texts), (int) T::views.size());
+            }
+
+            // Copy arg I's parsed value out of the parser
+            template <std::size_t I>
+            void CopyValue(SAH_Parser *parser)
+            {
+                using T = std::tuple_element_t<I, std::tuple<typename Options::Type...>>;
+                auto &slot = std::get<I>(values);
+                ArgHandle handle = (ArgHandle) I;
+                slot.set = SAH_HasArgH(parser, handle);
+                if (!slot.set) return;
+
+                if constexpr (std::is_same_v<T, bool>) slot.value = true;
+                else if constexpr (std::is_same_v<T, int> || std::is_same_v<T, Count>) slot.value = SAH_GetIntArgH(parser, handle);
+                else if constexpr (std::is_same_v<T, float>) slot.value = SAH_GetFloatArgH(parser, handle);
+                else if constexpr (std::is_same_v<T, char>) slot.value = SAH_GetCharArgH(parser, handle);
+                else if constexpr (std::is_same_v<T, const char*>) slot.value = SAH_GetStringArgH(parser, handle);
+                else if constexpr (std::is_same_v<T, double>) slot.value = SAH_GetDoubleArgH(parser, handle);
+                else if constexpr (std::is_same_v<T, int64_t>) slot.value = SAH_GetInt64ArgH(parser, handle);
+                else if constexpr (std::is_same_v<T, uint64_t>) slot.value = SAH_GetUInt64ArgH(parser, handle);
+                else slot.value = SAH_GetChoiceArgH(parser, handle);
+            }
+
+        public:
+            // Same as InitArgs(argc, argv, appDescription): the C parser parses argv, then the values are copied out of it
+            // (strings still point into argv) and its memory is freed
+            Args(int argc, const char *argv[], const char *appDescription)
+            {
+                SAH_Parser parser {};
+                [&]<std::size_t... I>(std::index_sequence<I...>)
+                {
+                    (AddArg<I>(&parser), ...);
+                    SAH_InitArgs(&parser, argc, argv, appDescription);
+                    (CopyValue<I>(&parser), ...);
+                }(std::index_sequence_for<Options...>());
+                SAH_FreeArgs(&parser);
+            }
+
+            // True if the argument was given (same as HasArg(), and GetBoolArg() for bools)
+            template <Name Key>
+            bool has() const
+            {
+                constexpr std::size_t index = Find(Key.View());
+                static_assert(index < count, "simplearghandler: Unknown argument name");
+                return std::get<index>(values).set;
+            }
+
+            // Value of the argument, a direct field read (quits like Get*Arg() if a non-bool wasn't given, counts are 0)
+            template <Name Key>
+            auto get() const
+            {
+                constexpr std::size_t index = Find(Key.View());
+                static_assert(index < count, "simplearghandler: Unknown argument name");
+                const auto &slot = std::get<index>(values);
+
+                if constexpr (argTypes[index] != ARG_BOOL && !(argTypes[index] & ARG_COUNT))
+                {
+                    if (!slot.set)
+                    {
+                        printf("simplearghandler: Error: %.*s not found\n", (int) Key.View().size(), Key.View().data());
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                return slot.value;
+            }
+        };
+    }
+
+#endif